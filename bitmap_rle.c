@@ -0,0 +1,82 @@
+#include "bitmap_rle.h"
+
+// pgm_read_byte() may be a macro
+static uint8_t read_progmem(const uint8_t *address) {
+    return pgm_read_byte(address);
+}
+
+void bitmap_rle_draw(const uint8_t *data, uint16_t size) {
+    // generated at build time, so the data is trusted to hold a whole image
+    bitmap_rle_draw_with(read_progmem, data, UINT16_MAX, size);
+}
+
+uint16_t bitmap_rle_unpack(const uint8_t *data, uint16_t length, uint8_t *out, uint16_t size) {
+    const uint8_t *end = data + length;
+    uint16_t index = 0;
+
+    while (data < end && index < size) {
+        uint8_t control = *data++;
+        uint8_t op = control & RLE_OP_MASK;
+        uint8_t count = (control & RLE_COUNT_MASK) + 1;
+
+        if (op == RLE_OP_LITERAL) {
+            if (count > end - data) break;
+            for (; count && index < size; count--, index++, data++) {
+                if (out) out[index] = *data;
+            }
+            continue;
+        }
+
+        uint8_t value = op == RLE_OP_ONES ? 0xFF : 0x00;
+        if (op == RLE_OP_REPEAT) {
+            if (data == end) break;
+            count++;
+            value = *data++;
+        }
+
+        for (; count && index < size; count--, index++) {
+            if (out) out[index] = value;
+        }
+    }
+
+    return index;
+}
+
+void bitmap_rle_draw_with(bitmap_reader_t read, const uint8_t *data, uint16_t length, uint16_t size) {
+    uint16_t index = 0;
+
+    while (index < size && length) {
+        uint8_t control = read(data++);
+        uint8_t op = control & RLE_OP_MASK;
+        uint8_t count = (control & RLE_COUNT_MASK) + 1;
+        uint8_t value = 0;
+        length--;
+
+        switch (op) {
+            case RLE_OP_LITERAL:
+                if (count > length) count = length;
+                length -= count;
+                break;
+            case RLE_OP_REPEAT:
+                if (!length) return;
+                count++;
+                value = read(data++);
+                length--;
+                break;
+            case RLE_OP_ZEROS:
+                value = 0x00;
+                break;
+            case RLE_OP_ONES:
+                value = 0xFF;
+                break;
+        }
+
+        for (; count && index < size; count--) {
+            if (op == RLE_OP_LITERAL) {
+                value = read(data++);
+            }
+            // only marks the OLED dirty where the byte actually changes
+            oled_write_raw_byte(value, index++);
+        }
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "quantum.h"
+
+// Decoder for the RLE images macropad_bitmaps.py writes to bitmaps.c. Each
+// run starts with a control byte, the top two bits are the op and the low six
+// bits are n:
+//
+// | 00 | literal, the next n + 1 bytes are copied
+// | 01 | repeat, the next byte is written n + 2 times
+// | 10 | n + 1 bytes of 0x00
+// | 11 | n + 1 bytes of 0xFF
+
+#define RLE_OP_MASK 0xC0
+#define RLE_COUNT_MASK 0x3F
+
+#define RLE_OP_LITERAL 0x00
+#define RLE_OP_REPEAT 0x40
+#define RLE_OP_ZEROS 0x80
+#define RLE_OP_ONES 0xC0
+
+// reads one byte of image data, like pgm_read_byte() or eeprom_read_byte()
+typedef uint8_t (*bitmap_reader_t)(const uint8_t *address);
+
+// Decodes a PROGMEM image straight into the OLED buffer, size bytes from the
+// top left like oled_write_raw_P(). Never writes more than size bytes, so the
+// decode time is bounded by the image size and not by the data.
+void bitmap_rle_draw(const uint8_t *data, uint16_t size);
+
+// Same for image data that isn't in flash, such as uploaded images in EEPROM.
+// Never reads more than length bytes of data either.
+void bitmap_rle_draw_with(bitmap_reader_t read, const uint8_t *data, uint16_t length, uint16_t size);
+
+// Decodes length bytes of RLE data from RAM into out, writing at most size
+// bytes. A run cut short by the end of the data stops the decode. Returns the
+// number of bytes written. With a NULL out the bytes are only counted, to
+// check data before it is kept.
+uint16_t bitmap_rle_unpack(const uint8_t *data, uint16_t length, uint8_t *out, uint16_t size);
@@ -1,265 +1,134 @@
+// Generated by macropad_bitmaps.py, don't edit by hand
+
 #include "bitmaps.h"
 #include QMK_KEYBOARD_H
 
+// gungeon: 186 bytes, 768 raw
 const unsigned char bitmap_gungeon[] PROGMEM = {
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0x1f, 0x1f, 0x07, 0x07, 0x01, 0x01, 0x81, 0x81, 0x80, 0xe0, 0xe0, 
-	0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x07, 0x07, 0x1f, 0x1f, 0x7f, 0x7f, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xf0, 0xff, 0xff, 0xff, 0x3f, 0x3f, 
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0x3f, 0x3f, 0x0f, 0x0f, 
-	0x0f, 0x0f, 0x3f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xfc, 0xfc, 0x00, 0x00, 0x00, 0xc0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xfc, 0xfc, 
-	0xfc, 0xfc, 0xfc, 0xfc, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0, 0xf0, 
-	0x0f, 0x0f, 0x3f, 0x3f, 0xcf, 0xcf, 0xcf, 0xcf, 0xcf, 0xe3, 0xe3, 0xe3, 0xe3, 0xe3, 0xe3, 0xe3, 
-	0xe3, 0xe3, 0xe3, 0xe3, 0xe3, 0xf0, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xfe, 0xfe, 0xff, 0xff, 
-	0xfc, 0xfc, 0x00, 0x00, 0x01, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xfc, 0xfc, 0x00, 0x03, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0x3f, 0x3f, 0xff, 0xff, 0xcf, 0xcf, 0xcf, 0xcf, 0xcf, 0xcf, 0xff, 0xff, 0xcf, 0xcf, 0xff, 0xff, 
-	0xf0, 0xf0, 0x0f, 0x0f, 0x3f, 0x3f, 0x3f, 0x03, 0x03, 0x3c, 0x3c, 0x3c, 0x3c, 0x30, 0x30, 0x00, 
-	0x00, 0xff, 0xff, 0x03, 0x03, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 
-	0xf0, 0xf0, 0xf8, 0xfc, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x03, 0x03, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0x3f, 0x3f, 0xcf, 0xcf, 0xf3, 0xf3, 0xf3, 0xf3, 0xf3, 0xf3, 0xf3, 0xf3, 0xfc, 0xfc, 0xfc, 0xfc, 
-	0xfc, 0xfc, 0xf0, 0xf0, 0x00, 0x00, 0x00, 0xfc, 0xfc, 0xfc, 0xfc, 0x0f, 0x0f, 0xc3, 0xc3, 0xc0, 
-	0xc0, 0xf0, 0xf0, 0xfc, 0xfc, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xcf, 0xcf, 0xc3, 0xc3, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 
-	0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0xcf, 0xcf, 0xcf, 0xcf, 0xf3, 0xf3, 0xf3, 0xf3, 
-	0xf0, 0xf0, 0xc3, 0xc3, 0xc3, 0xc2, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xfc, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+	0xe4, 0x0a, 0x1f, 0x1f, 0x07, 0x07, 0x01, 0x01, 0x81, 0x81, 0x80, 0xe0, 0xe0, 0x83, 0x42, 0x01,
+	0x05, 0x07, 0x07, 0x1f, 0x1f, 0x7f, 0x7f, 0xff, 0xe4, 0x01, 0x01, 0x01, 0x83, 0x01, 0xf0, 0xf0,
+	0xc2, 0x01, 0x3f, 0x3f, 0x8d, 0xdc, 0x41, 0x3f, 0x42, 0x0f, 0x00, 0x3f, 0xff, 0x01, 0xfc, 0xfc,
+	0x82, 0x00, 0xc0, 0x43, 0xf0, 0x44, 0xfc, 0xc9, 0x05, 0xf0, 0xf0, 0x0f, 0x0f, 0x3f, 0x3f, 0x43,
+	0xcf, 0x4a, 0xe3, 0x00, 0xf0, 0x44, 0xf8, 0x01, 0xfe, 0xfe, 0xc1, 0x01, 0xfc, 0xfc, 0x81, 0x00,
+	0x01, 0xff, 0x01, 0xfc, 0xfc, 0x80, 0x00, 0x03, 0xc6, 0x01, 0x3f, 0x3f, 0xc1, 0x44, 0xcf, 0xc1,
+	0x01, 0xcf, 0xcf, 0xc1, 0x03, 0xf0, 0xf0, 0x0f, 0x0f, 0x41, 0x3f, 0x01, 0x03, 0x03, 0x42, 0x3c,
+	0x01, 0x30, 0x30, 0x81, 0xc1, 0x01, 0x03, 0x03, 0x4b, 0xf0, 0x02, 0xf8, 0xfc, 0xfe, 0xff, 0xc1,
+	0x81, 0x01, 0x03, 0x03, 0xc4, 0x03, 0x3f, 0x3f, 0xcf, 0xcf, 0x46, 0xf3, 0x44, 0xfc, 0x01, 0xf0,
+	0xf0, 0x82, 0x42, 0xfc, 0x09, 0x0f, 0x0f, 0xc3, 0xc3, 0xc0, 0xc0, 0xf0, 0xf0, 0xfc, 0xfc, 0xff,
+	0xcb, 0x03, 0xcf, 0xcf, 0xc3, 0xc3, 0x49, 0xc0, 0x46, 0x3f, 0x42, 0xcf, 0x42, 0xf3, 0x01, 0xf0,
+	0xf0, 0x41, 0xc3, 0x00, 0xc2, 0x43, 0xc0, 0x00, 0xfc, 0xf3,
 };
 
-const unsigned char bitmap_gungeoneers [] PROGMEM = {
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 
-	0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0xbf, 0xbf, 0xbf, 0xbf, 0x3f, 0x3f, 0x3f, 0x7f, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0x7f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 
-	0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x1f, 0x7f, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 
-	0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 
-	0x7f, 0x7f, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0f, 0x0f, 0x03, 0x31, 0x31, 0x7c, 
-	0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0f, 0x0f, 0x3f, 0x3f, 0x0e, 0x00, 0x00, 0x00, 0x01, 0x01, 
-	0x03, 0x0f, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0x03, 0x03, 0x01, 0x01, 0x00, 0x00, 0x00, 0xc0, 0xc0, 0xc0, 0xc0, 0xce, 0xce, 0xce, 0xce, 0xce, 
-	0xce, 0xce, 0xce, 0xce, 0xce, 0xce, 0xcc, 0xcc, 0x01, 0x01, 0x03, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01, 0x01, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 
-	0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 
-	0x06, 0x06, 0xfe, 0x01, 0x01, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x0c, 0x00, 0x20, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x20, 0x00, 0x0c, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0x80, 0x80, 0x00, 0x00, 0x00, 0xf8, 0xf8, 0xe7, 0xe7, 0x07, 0x07, 0x1f, 0x1f, 0xe7, 0xe7, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0x07, 0x07, 0xe7, 0xe7, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0, 0xf0, 0x00, 0x00, 0xf0, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0x00, 0x00, 0x06, 0x06, 0x00, 0x00, 0x38, 0x30, 0x30, 0x30, 0x30, 0x38, 0x00, 0x00, 0x06, 0x06, 
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc0, 0xc0, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0x00, 0x00, 0xf8, 0xf8, 0xf8, 0xf8, 0x00, 0x00, 
-	0x00, 0xfc, 0xfc, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0f, 0x0f, 
-	0x07, 0x07, 0x00, 0x00, 0x00, 0xf9, 0xf9, 0xf1, 0xf1, 0x30, 0x30, 0x30, 0x30, 0x37, 0x37, 0xf7, 
-	0x37, 0x37, 0x37, 0x37, 0x30, 0x30, 0x31, 0x31, 0x00, 0x00, 0x06, 0x0f, 0x0f, 0x3f, 0x3f, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf8, 0xf8, 0xe7, 0xe7, 0xe7, 0xe7, 0x07, 0x07, 
-	0x06, 0x06, 0xf6, 0x36, 0x36, 0xf6, 0xf6, 0xf6, 0xf6, 0xf6, 0xf6, 0xf6, 0xf6, 0x06, 0x06, 0xe6, 
-	0xe6, 0xe6, 0xe7, 0xf8, 0xf8, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc3, 0x00, 0x00, 0x03, 
-	0x03, 0x03, 0x03, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x03, 0x03, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 
-	0x03, 0xc0, 0xc0, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xf0, 0xf0, 0xe0, 0xe0, 0x80, 0x80, 0x80, 0x03, 0x03, 0x83, 0x83, 0x83, 0x83, 0x83, 0x83, 0x8f, 
-	0x83, 0x83, 0x83, 0x83, 0x03, 0x03, 0x83, 0x83, 0xe0, 0xe0, 0x80, 0x80, 0x80, 0xe0, 0xe0, 0xf0, 
-	0xf0, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0, 0xf0, 
-	0x00, 0x00, 0xff, 0x08, 0x08, 0xcf, 0xcf, 0xcf, 0x0f, 0x0f, 0xff, 0x0f, 0x0f, 0xf0, 0xf0, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe, 
-	0xfe, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe, 0xfe, 0xfe, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xfe, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xfe, 0xfe, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe, 0xfe, 0xfe, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+// gungeoneers: 298 bytes, 768 raw
+const unsigned char bitmap_gungeoneers[] PROGMEM = {
+	0xce, 0x00, 0x7f, 0x44, 0x3f, 0x42, 0xbf, 0x41, 0x3f, 0x00, 0x7f, 0xd5, 0x00, 0x7f, 0x4f, 0x1f,
+	0x01, 0x7f, 0x7f, 0xd1, 0x57, 0x7f, 0xd6, 0x05, 0x0f, 0x0f, 0x03, 0x31, 0x31, 0x7c, 0x44, 0x0e,
+	0x04, 0x0f, 0x0f, 0x3f, 0x3f, 0x0e, 0x82, 0x04, 0x01, 0x01, 0x03, 0x0f, 0x0f, 0xcc, 0x03, 0x03,
+	0x03, 0x01, 0x01, 0x82, 0x42, 0xc0, 0x49, 0xce, 0x04, 0xcc, 0xcc, 0x01, 0x01, 0x03, 0xcc, 0x01,
+	0x01, 0x01, 0x44, 0xfe, 0x50, 0x06, 0x02, 0xfe, 0x01, 0x01, 0xd4, 0x87, 0x00, 0x0c, 0x80, 0x00,
+	0x20, 0x44, 0x60, 0x00, 0x20, 0x80, 0x00, 0x0c, 0x84, 0xcc, 0x01, 0x80, 0x80, 0x82, 0x09, 0xf8,
+	0xf8, 0xe7, 0xe7, 0x07, 0x07, 0x1f, 0x1f, 0xe7, 0xe7, 0xc4, 0x03, 0x07, 0x07, 0xe7, 0xe7, 0x82,
+	0xca, 0x01, 0xf0, 0xf0, 0x81, 0x00, 0xf0, 0xc4, 0x81, 0x01, 0x06, 0x06, 0x81, 0x00, 0x38, 0x42,
+	0x30, 0x00, 0x38, 0x81, 0x01, 0x06, 0x06, 0x81, 0xc0, 0x81, 0xd4, 0x01, 0xc0, 0xc0, 0x85, 0x44,
+	0xf8, 0x81, 0x42, 0xf8, 0x82, 0x01, 0xfc, 0xfc, 0xca, 0x03, 0x0f, 0x0f, 0x07, 0x07, 0x82, 0x03,
+	0xf9, 0xf9, 0xf1, 0xf1, 0x42, 0x30, 0x02, 0x37, 0x37, 0xf7, 0x42, 0x37, 0x03, 0x30, 0x30, 0x31,
+	0x31, 0x81, 0x04, 0x06, 0x0f, 0x0f, 0x3f, 0x3f, 0xc8, 0x01, 0xf8, 0xf8, 0x42, 0xe7, 0x06, 0x07,
+	0x07, 0x06, 0x06, 0xf6, 0x36, 0x36, 0x46, 0xf6, 0x01, 0x06, 0x06, 0x41, 0xe6, 0x02, 0xe7, 0xf8,
+	0xf8, 0xd6, 0x00, 0xc3, 0x81, 0x42, 0x03, 0x43, 0x3f, 0x01, 0x03, 0x03, 0x44, 0x3f, 0x02, 0x03,
+	0xc0, 0xc0, 0xcc, 0x03, 0xf0, 0xf0, 0xe0, 0xe0, 0x41, 0x80, 0x01, 0x03, 0x03, 0x44, 0x83, 0x00,
+	0x8f, 0x42, 0x83, 0x05, 0x03, 0x03, 0x83, 0x83, 0xe0, 0xe0, 0x41, 0x80, 0x03, 0xe0, 0xe0, 0xf0,
+	0xf0, 0xcc, 0x01, 0xf0, 0xf0, 0x81, 0xc0, 0x01, 0x08, 0x08, 0x41, 0xcf, 0x01, 0x0f, 0x0f, 0xc0,
+	0x03, 0x0f, 0x0f, 0xf0, 0xf0, 0xdf, 0x41, 0xfe, 0xca, 0x41, 0xfe, 0xd6, 0x01, 0xfe, 0xfe, 0xca,
+	0x01, 0xfe, 0xfe, 0xda, 0x41, 0xfe, 0xc4, 0x41, 0xfe, 0xd3,
 };
 
-const unsigned char bitmap_space [] PROGMEM = {
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7b, 0x3f, 0x3f, 0x3f, 0x9f, 0x9f, 0x9f, 0x9f, 
-	0x9f, 0x1f, 0x1f, 0x3f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x3b, 0x3f, 0x7f, 0x7f, 0x7f, 
-	0xff, 0xff, 0x7f, 0x7f, 0x3f, 0xbf, 0x9f, 0xcf, 0xcf, 0xef, 0xef, 0x6f, 0x6f, 0x6f, 0x67, 0x77, 
-	0x77, 0x77, 0xf7, 0xf7, 0xf7, 0xf7, 0xc7, 0xcf, 0x1f, 0xff, 0xff, 0xff, 0xff, 0xdf, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0x3f, 0x1f, 0x87, 0xe3, 0xf1, 0xf8, 0xfc, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xfc, 0xf8, 0xe3, 0xc7, 0x0f, 0x3f, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0x3f, 0x07, 0x07, 0x03, 0x03, 
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x02, 0x03, 0x01, 0x3d, 0x3d, 0xfd, 0xf5, 0xfe, 0xfe, 0xfe, 0xff, 0xff, 0xdf, 0xff, 
-	0x7f, 0x0e, 0xe0, 0xff, 0x7f, 0x1f, 0xc3, 0xf0, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x87, 0x83, 0x19, 0x19, 0x79, 0x79, 0xf9, 0xf9, 0xf9, 
-	0xf9, 0xf8, 0xfc, 0xfe, 0xff, 0xff, 0xff, 0xff, 0x7f, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0x7f, 0x7f, 0xff, 0xff, 0xff, 0xfe, 0xfc, 0xf8, 0xf9, 0xf9, 0xf9, 0x79, 0x79, 0x19, 0x19, 0x83, 
-	0x87, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfd, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xc3, 0xc3, 0xcf, 0x67, 0x33, 0xbb, 0x99, 0xdc, 0xce, 
-	0xe6, 0xf3, 0xf9, 0xfd, 0xfc, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0xff, 0xff, 0xfe, 0xfe, 0xfc, 0xfc, 0x01, 0x01, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xc1, 0xc1, 0xc0, 0xc0, 0xff, 0xff, 0xff, 0xff, 0xc1, 0xc1, 
-	0xc0, 0xc0, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01, 0x01, 0xfc, 0xfc, 0xfe, 0xfe, 0xff, 
-	0xff, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0xbf, 0x8f, 
-	0xef, 0x23, 0x3b, 0x39, 0x8d, 0xcc, 0xe0, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0xc0, 0xc0, 0xe0, 0xe0, 0x30, 
-	0x38, 0x38, 0x1c, 0x0c, 0x0e, 0x03, 0x03, 0xc3, 0xc1, 0xfc, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xdf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0, 0xe0, 0x80, 
-	0x80, 0x1f, 0x1f, 0x7f, 0x7f, 0x0f, 0x0f, 0x8f, 0x8f, 0x8f, 0x8f, 0x8f, 0x8f, 0x8f, 0x8f, 0x8f, 
-	0x8f, 0x8f, 0x0f, 0x0f, 0x7f, 0x1f, 0x1f, 0x00, 0x80, 0xe0, 0xf0, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0f, 0xc7, 0xf3, 0xfb, 0xf8, 0xfe, 0x0e, 0xc3, 0xf8, 
-	0xfc, 0xfe, 0xff, 0xff, 0x37, 0x3f, 0x3f, 0x3f, 0xbf, 0xbf, 0xb0, 0x90, 0xc0, 0xc0, 0x40, 0x60, 
-	0x30, 0x30, 0x30, 0x18, 0x0c, 0x0e, 0x0e, 0x06, 0x07, 0x03, 0x03, 0x01, 0x01, 0x00, 0x00, 0x00, 
-	0x00, 0xc0, 0xc0, 0xf0, 0xf0, 0xfc, 0xfc, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xfe, 0xfc, 0xf8, 0xf8, 0xfc, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdf, 0xff, 0xff, 
-	0xff, 0xff, 0xfe, 0xfc, 0xf8, 0xf8, 0xfc, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0, 0xe3, 0xef, 0xef, 0xef, 0xef, 0xee, 0xee, 0xee, 
-	0xee, 0xe6, 0xf6, 0xf6, 0xf7, 0xf7, 0xf3, 0xf3, 0xf9, 0xfd, 0xfd, 0xfd, 0xfc, 0xfc, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 0xfe, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xff, 0xff, 0xff
+// hollowknight: 292 bytes, 768 raw
+const unsigned char bitmap_hollowknight[] PROGMEM = {
+	0xf4, 0x04, 0x7f, 0x7f, 0x3f, 0x3f, 0xbf, 0xc8, 0x03, 0xbf, 0x3f, 0x3f, 0x7f, 0xcf, 0x02, 0x3f,
+	0x1f, 0x5f, 0xc1, 0x05, 0xef, 0xef, 0xaf, 0x1f, 0x3f, 0x7f, 0xf1, 0x05, 0x1f, 0xe7, 0xfb, 0x1d,
+	0xe5, 0xfb, 0xc9, 0x05, 0xfb, 0xe5, 0x1d, 0xfb, 0xe7, 0x1f, 0xc8, 0x04, 0xe1, 0xc1, 0x04, 0x1c,
+	0x3e, 0x4a, 0x3f, 0x04, 0x3e, 0x3e, 0x1c, 0x80, 0xe1, 0xcb, 0x02, 0xf9, 0xc0, 0x80, 0x80, 0x02,
+	0x3e, 0x3f, 0x1f, 0x42, 0x0f, 0x01, 0xc0, 0xc0, 0x80, 0x01, 0x03, 0x7f, 0xee, 0x07, 0xfe, 0xf9,
+	0xf7, 0x0f, 0x18, 0x13, 0x37, 0xe7, 0x42, 0x07, 0x00, 0xc7, 0x41, 0xf7, 0x05, 0xfb, 0xf8, 0x0f,
+	0xf7, 0xf9, 0xfe, 0xcc, 0x81, 0x03, 0x70, 0xf8, 0xf8, 0x70, 0x82, 0x03, 0x70, 0xf8, 0xf8, 0x70,
+	0x81, 0xd2, 0x05, 0xf8, 0x60, 0x42, 0x07, 0x07, 0x06, 0x82, 0x02, 0x60, 0xf0, 0xf8, 0xf0, 0x10,
+	0x3f, 0x30, 0xc0, 0x86, 0x8f, 0x8f, 0x86, 0x80, 0x80, 0x8f, 0x9f, 0xb9, 0xb0, 0x30, 0xb9, 0xcf,
+	0xf0, 0xce, 0x00, 0xbf, 0xc0, 0x02, 0xfc, 0x78, 0x18, 0x86, 0x03, 0x18, 0x78, 0xfe, 0xb7, 0xcb,
+	0x02, 0x3f, 0x1f, 0x1f, 0x41, 0x7f, 0x01, 0x3f, 0x1f, 0x89, 0x02, 0x03, 0x0f, 0x3f, 0x42, 0x7f,
+	0x02, 0x0f, 0x07, 0x0f, 0xe8, 0x02, 0xfc, 0xf0, 0x80, 0x80, 0x02, 0x80, 0xe0, 0x3f, 0x80, 0x02,
+	0x7f, 0xc0, 0x80, 0x81, 0x00, 0x01, 0xcd, 0x00, 0xbf, 0xc1, 0x02, 0xdf, 0x67, 0x01, 0x8a, 0x01,
+	0x01, 0x6f, 0xc1, 0x00, 0xbb, 0xc8, 0x02, 0xfe, 0xc6, 0x82, 0x81, 0x03, 0x60, 0xf0, 0xf8, 0x80,
+	0x8a, 0x02, 0xf0, 0xe0, 0x80, 0x81, 0x02, 0xc4, 0xfc, 0xfe, 0xec, 0x0b, 0xf9, 0xe0, 0xf0, 0xf0,
+	0xfc, 0xf0, 0xe1, 0xfb, 0xfa, 0xfc, 0xf8, 0xf9, 0xcb, 0x16, 0xe3, 0xf2, 0xf9, 0xd0, 0xf6, 0xfa,
+	0xf0, 0xf6, 0xec, 0xd6, 0xe0, 0xfe, 0xf9, 0xec, 0xe8, 0xe6, 0xec, 0xf0, 0xf2, 0xe4, 0xf1, 0xd3,
+	0xf7, 0xd0, 0x0b, 0xfc, 0xe0, 0xe0, 0xfc, 0xfe, 0xfc, 0xfc, 0xe0, 0xe0, 0xfc, 0xfe, 0xfe, 0xc1,
+	0x01, 0xfe, 0xfe, 0xd4,
 };
 
-const unsigned char bitmap_hollowknight [] PROGMEM = {
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0x7f, 0x3f, 0x3f, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xbf, 0x3f, 0x3f, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0x1f, 0x5f, 0xff, 0xff, 0xef, 0xef, 0xaf, 0x1f, 
-	0x3f, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0x1f, 0xe7, 0xfb, 0x1d, 0xe5, 0xfb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xfb, 0xe5, 0x1d, 0xfb, 0xe7, 0x1f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xe1, 0xc1, 0x04, 0x1c, 0x3e, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 
-	0x3f, 0x3f, 0x3f, 0x3f, 0x3e, 0x3e, 0x1c, 0x80, 0xe1, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xf9, 0xc0, 0x80, 0x00, 0x3e, 0x3f, 0x1f, 0x0f, 0x0f, 0x0f, 0x0f, 
-	0xc0, 0xc0, 0x00, 0x03, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xfe, 0xf9, 0xf7, 0x0f, 0x18, 0x13, 0x37, 0xe7, 0x07, 0x07, 0x07, 0x07, 
-	0xc7, 0xf7, 0xf7, 0xf7, 0xfb, 0xf8, 0x0f, 0xf7, 0xf9, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x70, 0xf8, 0xf8, 0x70, 0x00, 0x00, 0x00, 
-	0x70, 0xf8, 0xf8, 0x70, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf8, 0x60, 0x42, 0x07, 0x07, 0x06, 0x00, 
-	0x00, 0x00, 0x60, 0xf0, 0xf8, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x3f, 0x30, 0xc0, 0x86, 0x8f, 0x8f, 0x86, 0x80, 0x80, 0x8f, 
-	0x9f, 0xb9, 0xb0, 0x30, 0xb9, 0xcf, 0xf0, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xbf, 0xff, 0xfc, 0x78, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x18, 0x78, 0xfe, 0xb7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0x3f, 0x1f, 0x1f, 0x7f, 0x7f, 0x7f, 0x3f, 0x1f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x03, 0x0f, 0x3f, 0x7f, 0x7f, 0x7f, 0x7f, 0x0f, 0x07, 0x0f, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfc, 0xf0, 0x80, 0x00, 0x80, 0xe0, 0x3f, 0x00, 0x7f, 
-	0xc0, 0x80, 0x00, 0x00, 0x01, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xbf, 0xff, 0xff, 0xdf, 0x67, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x01, 0x6f, 0xff, 0xff, 0xbb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xfe, 0xc6, 0x82, 0x00, 0x00, 0x60, 0xf0, 0xf8, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf0, 0xe0, 0x80, 0x00, 0x00, 0xc4, 0xfc, 0xfe, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf9, 0xe0, 0xf0, 0xf0, 0xfc, 
-	0xf0, 0xe1, 0xfb, 0xfa, 0xfc, 0xf8, 0xf9, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xe3, 0xf2, 0xf9, 0xd0, 0xf6, 0xfa, 0xf0, 0xf6, 0xec, 0xd6, 0xe0, 0xfe, 0xf9, 
-	0xec, 0xe8, 0xe6, 0xec, 0xf0, 0xf2, 0xe4, 0xf1, 0xd3, 0xf7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfc, 0xe0, 0xe0, 0xfc, 0xfe, 
-	0xfc, 0xfc, 0xe0, 0xe0, 0xfc, 0xfe, 0xfe, 0xff, 0xff, 0xfe, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+// outer_wilds: 417 bytes, 768 raw
+const unsigned char bitmap_outer_wilds[] PROGMEM = {
+	0xd1, 0x03, 0x7f, 0xef, 0xf7, 0xaf, 0xc9, 0x00, 0x7f, 0xd4, 0x01, 0x07, 0x77, 0x43, 0xf7, 0x00,
+	0x07, 0xd5, 0x01, 0x7f, 0x3f, 0x41, 0x0f, 0x01, 0x07, 0x07, 0x46, 0x01, 0x01, 0x03, 0x8f, 0xdd,
+	0x00, 0x7f, 0xc2, 0x07, 0xfe, 0xe1, 0xc7, 0x1f, 0x9f, 0xfb, 0xcf, 0x3f, 0xc2, 0x03, 0xfe, 0xc1,
+	0x17, 0xda, 0xc3, 0x00, 0x9f, 0xc0, 0x05, 0x3f, 0x85, 0x47, 0x6c, 0x3d, 0x5f, 0xc8, 0x00, 0x7f,
+	0x42, 0xbf, 0x02, 0x3f, 0x3f, 0x7f, 0xc3, 0x0a, 0xfc, 0xfd, 0x3d, 0xb8, 0xba, 0x9a, 0x98, 0x98,
+	0x99, 0x81, 0xc3, 0xc1, 0x07, 0xc7, 0x47, 0x1b, 0x1b, 0x7b, 0xb3, 0x07, 0x1f, 0xc5, 0x00, 0xf0,
+	0x86, 0x03, 0x03, 0x06, 0x3c, 0x78, 0x41, 0xf8, 0x03, 0x1c, 0x06, 0x03, 0x01, 0x84, 0x00, 0x83,
+	0xd8, 0x0a, 0xfc, 0xfd, 0xe9, 0xd3, 0x5f, 0x9f, 0x5a, 0x18, 0x01, 0x06, 0x0b, 0x80, 0x02, 0x07,
+	0x07, 0x01, 0x80, 0x00, 0x06, 0x80, 0x42, 0x07, 0x05, 0x03, 0x08, 0x0e, 0x06, 0x71, 0xfc, 0xca,
+	0x00, 0x78, 0x41, 0x3b, 0x05, 0x39, 0x39, 0x78, 0x78, 0x39, 0x3b, 0x41, 0x03, 0x00, 0x07, 0x80,
+	0x10, 0x01, 0x01, 0x07, 0x07, 0x03, 0x0b, 0x3b, 0x0b, 0x38, 0x18, 0x38, 0x30, 0x04, 0x7c, 0x7c,
+	0xfe, 0xfe, 0xc7, 0x02, 0xfc, 0xfc, 0xc0, 0x47, 0x80, 0x80, 0x09, 0x01, 0x03, 0x06, 0x1c, 0xb8,
+	0x70, 0xe0, 0xd0, 0xb8, 0x7f, 0xdb, 0x00, 0xf3, 0xc0, 0x00, 0x01, 0x89, 0x03, 0xc0, 0x30, 0x08,
+	0x04, 0x80, 0x42, 0x02, 0x41, 0x01, 0x80, 0x03, 0x0f, 0x0f, 0xe6, 0xe6, 0xc6, 0x06, 0xf0, 0xf7,
+	0xe7, 0xe1, 0xe2, 0xf0, 0xfc, 0x41, 0xfe, 0xc2, 0x00, 0x70, 0x83, 0x03, 0x0c, 0x1e, 0x1e, 0x0c,
+	0x84, 0x04, 0x20, 0xe0, 0xe0, 0xe1, 0xe1, 0x42, 0x01, 0x05, 0x07, 0x87, 0x27, 0xc7, 0xe7, 0x0f,
+	0xd0, 0x07, 0xfe, 0xfd, 0xfb, 0xf7, 0xee, 0x1d, 0x7b, 0xf7, 0x41, 0xef, 0x43, 0xcf, 0x41, 0x8f,
+	0x02, 0x9f, 0x3f, 0x7f, 0xc9, 0x01, 0xdc, 0xdb, 0x81, 0x00, 0x80, 0x86, 0x04, 0x38, 0x0f, 0x10,
+	0x10, 0x20, 0x86, 0x06, 0x80, 0xc0, 0xc8, 0xd8, 0xd8, 0xfd, 0xfd, 0xc7, 0x04, 0x07, 0x77, 0xf7,
+	0xf3, 0x03, 0x43, 0x01, 0x02, 0x08, 0xfc, 0xfe, 0xc0, 0x05, 0xfe, 0xfe, 0xfc, 0xf8, 0x70, 0x30,
+	0x80, 0x01, 0x86, 0x87, 0xc0, 0x00, 0xfe, 0x81, 0x0c, 0xa0, 0xa1, 0xb5, 0xb8, 0xb8, 0xbe, 0x8c,
+	0xec, 0xee, 0xef, 0xe1, 0xfd, 0xfe, 0xd4, 0x00, 0x01, 0x80, 0x00, 0x38, 0xc3, 0x04, 0xe7, 0x87,
+	0x91, 0x83, 0x87, 0xc4, 0x01, 0x30, 0x01, 0xce, 0x07, 0xfe, 0xfc, 0xfc, 0xf8, 0xf8, 0xf0, 0xe0,
+	0xe0, 0x41, 0xf0, 0x01, 0xf8, 0xf8, 0x41, 0xfc, 0x00, 0xfe, 0xd0, 0x03, 0xfe, 0xf1, 0xe7, 0xef,
+	0x43, 0xee, 0x00, 0xf0, 0xc6, 0x01, 0xfc, 0xfa, 0x42, 0xfb, 0x01, 0xfd, 0xfc, 0xe3, 0x03, 0xfc,
+	0xf0, 0xe0, 0xe3, 0x41, 0xc7, 0x41, 0xcf, 0x07, 0xc7, 0xc7, 0xe7, 0xe7, 0xf1, 0xf8, 0xfc, 0xfe,
+	0xc2,
 };
 
-const unsigned char outer_wilds [] PROGMEM = {
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0x7f, 0xef, 0xf7, 0xaf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x07, 0x77, 0xf7, 0xf7, 0xf7, 0xf7, 0xf7, 0x07, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0x7f, 0x3f, 0x0f, 0x0f, 0x0f, 0x07, 0x07, 0x01, 0x01, 0x01, 0x01, 0x01, 
-	0x01, 0x01, 0x01, 0x03, 0x8f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0x7f, 0xff, 0xff, 0xff, 0xfe, 0xe1, 0xc7, 0x1f, 0x9f, 0xfb, 0xcf, 0x3f, 0xff, 
-	0xff, 0xff, 0xfe, 0xc1, 0x17, 0xda, 0xff, 0xff, 0xff, 0xff, 0x9f, 0xff, 0x3f, 0x85, 0x47, 0x6c, 
-	0x3d, 0x5f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f, 0xbf, 0xbf, 0xbf, 0xbf, 
-	0x3f, 0x3f, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xfc, 0xfd, 0x3d, 0xb8, 0xba, 0x9a, 0x98, 0x98, 0x99, 
-	0x81, 0xc3, 0xff, 0xff, 0xc7, 0x47, 0x1b, 0x1b, 0x7b, 0xb3, 0x07, 0x1f, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x06, 0x3c, 0x78, 0xf8, 0xf8, 
-	0xf8, 0x1c, 0x06, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x83, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xfc, 0xfd, 0xe9, 0xd3, 0x5f, 0x9f, 0x5a, 0x18, 0x01, 0x06, 0x0b, 0x00, 
-	0x07, 0x07, 0x01, 0x00, 0x06, 0x00, 0x07, 0x07, 0x07, 0x07, 0x03, 0x08, 0x0e, 0x06, 0x71, 0xfc, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x78, 0x3b, 0x3b, 0x3b, 0x39, 
-	0x39, 0x78, 0x78, 0x39, 0x3b, 0x03, 0x03, 0x03, 0x07, 0x00, 0x01, 0x01, 0x07, 0x07, 0x03, 0x0b, 
-	0x3b, 0x0b, 0x38, 0x18, 0x38, 0x30, 0x04, 0x7c, 0x7c, 0xfe, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xfc, 0xfc, 0xc0, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 
-	0x01, 0x03, 0x06, 0x1c, 0xb8, 0x70, 0xe0, 0xd0, 0xb8, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf3, 0xff, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0xc0, 0x30, 0x08, 0x04, 0x00, 0x02, 0x02, 0x02, 0x02, 0x01, 0x01, 0x01, 0x00, 
-	0x0f, 0x0f, 0xe6, 0xe6, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0, 0xf7, 0xe7, 0xe1, 0xe2, 
-	0xf0, 0xfc, 0xfe, 0xfe, 0xfe, 0xff, 0xff, 0xff, 0x70, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x1e, 0x1e, 
-	0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0xe0, 0xe0, 0xe1, 0xe1, 0x01, 0x01, 0x01, 0x01, 0x07, 
-	0x87, 0x27, 0xc7, 0xe7, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe, 0xfd, 0xfb, 0xf7, 0xee, 0x1d, 0x7b, 0xf7, 0xef, 0xef, 
-	0xef, 0xcf, 0xcf, 0xcf, 0xcf, 0xcf, 0x8f, 0x8f, 0x8f, 0x9f, 0x3f, 0x7f, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xdc, 0xdb, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x38, 0x0f, 0x10, 0x10, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xc0, 
-	0xc8, 0xd8, 0xd8, 0xfd, 0xfd, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x07, 0x77, 0xf7, 
-	0xf3, 0x03, 0x01, 0x01, 0x01, 0x01, 0x01, 0x08, 0xfc, 0xfe, 0xff, 0xfe, 0xfe, 0xfc, 0xf8, 0x70, 
-	0x30, 0x00, 0x86, 0x87, 0xff, 0xfe, 0x00, 0x00, 0xa0, 0xa1, 0xb5, 0xb8, 0xb8, 0xbe, 0x8c, 0xec, 
-	0xee, 0xef, 0xe1, 0xfd, 0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01, 0x00, 0x38, 0xff, 0xff, 0xff, 
-	0xff, 0xe7, 0x87, 0x91, 0x83, 0x87, 0xff, 0xff, 0xff, 0xff, 0xff, 0x30, 0x01, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe, 0xfc, 0xfc, 0xf8, 
-	0xf8, 0xf0, 0xe0, 0xe0, 0xf0, 0xf0, 0xf0, 0xf8, 0xf8, 0xfc, 0xfc, 0xfc, 0xfe, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe, 0xf1, 
-	0xe7, 0xef, 0xee, 0xee, 0xee, 0xee, 0xee, 0xf0, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfc, 
-	0xfa, 0xfb, 0xfb, 0xfb, 0xfb, 0xfd, 0xfc, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 
-	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfc, 0xf0, 0xe0, 0xe3, 0xc7, 
-	0xc7, 0xc7, 0xcf, 0xcf, 0xcf, 0xc7, 0xc7, 0xe7, 0xe7, 0xf1, 0xf8, 0xfc, 0xfe, 0xff, 0xff, 0xff
+// space: 389 bytes, 768 raw
+const unsigned char bitmap_space[] PROGMEM = {
+	0xce, 0x00, 0xef, 0xc7, 0x00, 0x7b, 0x41, 0x3f, 0x43, 0x9f, 0x02, 0x1f, 0x1f, 0x3f, 0xc8, 0x00,
+	0xdf, 0xd7, 0x00, 0xbf, 0xcc, 0x45, 0x3f, 0x01, 0x3b, 0x3f, 0x41, 0x7f, 0xc1, 0x08, 0x7f, 0x7f,
+	0x3f, 0xbf, 0x9f, 0xcf, 0xcf, 0xef, 0xef, 0x41, 0x6f, 0x00, 0x67, 0x41, 0x77, 0x42, 0xf7, 0x02,
+	0xc7, 0xcf, 0x1f, 0xc3, 0x00, 0xdf, 0xc4, 0x00, 0xfe, 0xc4, 0x00, 0xef, 0xc7, 0x07, 0x3f, 0x1f,
+	0x87, 0xe3, 0xf1, 0xf8, 0xfc, 0xfe, 0xc5, 0x06, 0xfc, 0xf8, 0xe3, 0xc7, 0x0f, 0x3f, 0x7f, 0xcb,
+	0x00, 0xbf, 0xc1, 0x00, 0xfe, 0xd2, 0x05, 0x3f, 0x3f, 0x07, 0x07, 0x03, 0x03, 0x91, 0x06, 0x02,
+	0x03, 0x01, 0x3d, 0x3d, 0xfd, 0xf5, 0x41, 0xfe, 0xc1, 0x00, 0xdf, 0xc0, 0x02, 0x7f, 0x0e, 0xe0,
+	0xc0, 0x04, 0x7f, 0x1f, 0xc3, 0xf0, 0xfe, 0xcd, 0x05, 0x87, 0x83, 0x19, 0x19, 0x79, 0x79, 0x42,
+	0xf9, 0x02, 0xf8, 0xfc, 0xfe, 0xc3, 0x01, 0x7f, 0x7f, 0xc5, 0x01, 0x7f, 0x7f, 0xc2, 0x02, 0xfe,
+	0xfc, 0xf8, 0x41, 0xf9, 0x05, 0x79, 0x79, 0x19, 0x19, 0x83, 0x87, 0xca, 0x00, 0xfd, 0xc9, 0x02,
+	0x7f, 0x03, 0x03, 0x9b, 0x0e, 0x80, 0xc3, 0xc3, 0xcf, 0x67, 0x33, 0xbb, 0x99, 0xdc, 0xce, 0xe6,
+	0xf3, 0xf9, 0xfd, 0xfc, 0xc5, 0x00, 0xfe, 0xc9, 0x00, 0xdf, 0xc1, 0x05, 0xfe, 0xfe, 0xfc, 0xfc,
+	0x01, 0x01, 0xc6, 0x03, 0xc1, 0xc1, 0xc0, 0xc0, 0xc3, 0x03, 0xc1, 0xc1, 0xc0, 0xc0, 0xc6, 0x05,
+	0x01, 0x01, 0xfc, 0xfc, 0xfe, 0xfe, 0xc1, 0x00, 0xdf, 0xca, 0x0a, 0x3f, 0xbf, 0x8f, 0xef, 0x23,
+	0x3b, 0x39, 0x8d, 0xcc, 0xe0, 0xf0, 0x90, 0x11, 0x80, 0x80, 0xc0, 0xc0, 0xe0, 0xe0, 0x30, 0x38,
+	0x38, 0x1c, 0x0c, 0x0e, 0x03, 0x03, 0xc3, 0xc1, 0xfc, 0xfe, 0xc4, 0x00, 0xdf, 0xdb, 0x09, 0xf0,
+	0xe0, 0x80, 0x80, 0x1f, 0x1f, 0x7f, 0x7f, 0x0f, 0x0f, 0x49, 0x8f, 0x04, 0x0f, 0x0f, 0x7f, 0x1f,
+	0x1f, 0x80, 0x02, 0x80, 0xe0, 0xf0, 0xcb, 0x0a, 0x0f, 0xc7, 0xf3, 0xfb, 0xf8, 0xfe, 0x0e, 0xc3,
+	0xf8, 0xfc, 0xfe, 0xc1, 0x00, 0x37, 0x41, 0x3f, 0x07, 0xbf, 0xbf, 0xb0, 0x90, 0xc0, 0xc0, 0x40,
+	0x60, 0x41, 0x30, 0x09, 0x18, 0x0c, 0x0e, 0x0e, 0x06, 0x07, 0x03, 0x03, 0x01, 0x01, 0x83, 0x05,
+	0xc0, 0xc0, 0xf0, 0xf0, 0xfc, 0xfc, 0xcc, 0x00, 0xbf, 0xc7, 0x00, 0xfe, 0xc8, 0x00, 0xfb, 0xc8,
+	0x05, 0xfe, 0xfc, 0xf8, 0xf8, 0xfc, 0xfe, 0xc5, 0x00, 0xdf, 0xc3, 0x05, 0xfe, 0xfc, 0xf8, 0xf8,
+	0xfc, 0xfe, 0xc6, 0x00, 0xf7, 0xc6, 0x01, 0xf0, 0xe3, 0x42, 0xef, 0x42, 0xee, 0x07, 0xe6, 0xf6,
+	0xf6, 0xf7, 0xf7, 0xf3, 0xf3, 0xf9, 0x41, 0xfd, 0x01, 0xfc, 0xfc, 0xc5, 0x47, 0xfe, 0xca, 0x00,
+	0xf7, 0xd2, 0x00, 0xef, 0xc2,
 };
 
 const unsigned char * const bitmaps_arr[NUM_IMAGES] PROGMEM = {
     bitmap_gungeon,
     bitmap_gungeoneers,
-    bitmap_space,
     bitmap_hollowknight,
-    outer_wilds,
-};
\ No newline at end of file
+    bitmap_outer_wilds,
+    bitmap_space,
+};
@@ -1,3 +1,5 @@
+// Generated by macropad_bitmaps.py, don't edit by hand
+
 #pragma once
 
 #include "quantum.h"
@@ -5,4 +7,6 @@
 // images are 128x48 pixels
 #define BITMAP_SIZE 768
 #define NUM_IMAGES 5
-extern const unsigned char * const bitmaps_arr[NUM_IMAGES];
\ No newline at end of file
+
+// RLE compressed, draw them with bitmap_rle_draw()
+extern const unsigned char * const bitmaps_arr[NUM_IMAGES];
@@ -8,4 +8,10 @@
 // COMMENT OUT FOR THE ENCODER FIRMWARE
 #define TAPPING_TERM 160
 #define COMBO_COUNT 4
-#define COMBO_TERM 50
\ No newline at end of file
+#define COMBO_TERM 50
+
+// EEPROM for uploaded arrows layer images, 4 slots of 785 bytes (image_slots.h)
+#define EECONFIG_USER_DATA_SIZE 3140
+// RP2040 EEPROM emulation, the default is too small for the image slots
+#define WEAR_LEVELING_LOGICAL_SIZE 8192
+#define WEAR_LEVELING_BACKING_SIZE 16384
\ No newline at end of file
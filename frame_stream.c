@@ -0,0 +1,132 @@
+#include "frame_stream.h"
+#include "bitmap_rle.h"
+#include "oled_render.h"
+#include "print.h"
+#include <string.h>
+
+frame_stream_stats_t frame_stream_stats;
+
+static bool active = false;
+static uint32_t last_report = 0;
+
+// the next frame as received so far, and the tiles it changed
+static uint8_t frame[FRAME_SIZE];
+static uint8_t changed[FRAME_TILES / 8];
+
+// counters for the current stats window
+static uint32_t window_start = 0;
+static uint16_t frames = 0;
+static uint16_t tiles = 0;
+static uint32_t bytes = 0;
+
+static uint16_t read_u16(const uint8_t *buf) {
+    return (uint16_t)buf[0] | ((uint16_t)buf[1] << 8);
+}
+
+static void mark_changed(uint16_t offset, uint16_t n) {
+    for (uint16_t tile = offset / FRAME_TILE_SIZE; tile * FRAME_TILE_SIZE < offset + n; tile++) {
+        changed[tile / 8] |= 1 << (tile % 8);
+    }
+}
+
+static void handle_data(const uint8_t *data, uint8_t length) {
+    uint16_t offset = read_u16(data + 2);
+    uint8_t n = data[4];
+
+    if (offset >= FRAME_SIZE || n > length - 5) return;
+
+    // an RLE report can fill far more than its n bytes
+    uint16_t written;
+    if (data[1] == FRAME_OP_RLE) {
+        written = bitmap_rle_unpack(data + 5, n, frame + offset, FRAME_SIZE - offset);
+    } else {
+        written = n < FRAME_SIZE - offset ? n : FRAME_SIZE - offset;
+        memcpy(frame + offset, data + 5, written);
+    }
+
+    mark_changed(offset, written);
+}
+
+static void update_stats(void) {
+    uint32_t elapsed = timer_elapsed32(window_start);
+    if (elapsed < RENDER_STATS_MS) {
+        return;
+    }
+
+    frame_stream_stats.frames = frames;
+    frame_stream_stats.tiles = tiles;
+    frame_stream_stats.bytes = bytes;
+
+#ifdef CONSOLE_ENABLE
+    uprintf("stream: %u frames, %u tiles, %lu bytes, %lu bytes/frame\n",
+            frames, tiles, bytes, frames ? bytes / frames : 0);
+#endif
+
+    window_start = timer_read32();
+    frames = 0;
+    tiles = 0;
+    bytes = 0;
+}
+
+// copies the changed tiles into the OLED buffer in one go
+static void show_frame(uint8_t seq) {
+    for (uint8_t tile = 0; tile < FRAME_TILES; tile++) {
+        if (!(changed[tile / 8] & (1 << (tile % 8)))) continue;
+
+        uint16_t start = tile * FRAME_TILE_SIZE;
+        for (uint16_t i = start; i < start + FRAME_TILE_SIZE; i++) {
+            // only marks the OLED dirty where the byte actually changes
+            oled_write_raw_byte(frame[i], i);
+        }
+        tiles++;
+    }
+
+    memset(changed, 0, sizeof(changed));
+    frame_stream_stats.last_seq = seq;
+    frames++;
+    update_stats();
+}
+
+static void start(void) {
+    memset(frame, 0, sizeof(frame));
+    memset(changed, 0, sizeof(changed));
+    oled_clear();
+    active = true;
+}
+
+static void stop(void) {
+    active = false;
+    render_invalidate();
+}
+
+bool frame_stream_receive(const uint8_t *data, uint8_t length) {
+    if (length < 2 || data[0] != FRAME_STREAM) return false;
+
+    last_report = timer_read32();
+    bytes += length;
+
+    switch (data[1]) {
+        case FRAME_OP_START:
+            start();
+            break;
+        case FRAME_OP_RAW:
+        case FRAME_OP_RLE:
+            if (active && length >= 5) handle_data(data, length);
+            break;
+        case FRAME_OP_END:
+            if (active && length >= 3) show_frame(data[2]);
+            break;
+        case FRAME_OP_STOP:
+            if (active) stop();
+            break;
+    }
+
+    return true;
+}
+
+bool frame_stream_active(void) {
+    if (active && timer_elapsed32(last_report) > FRAME_STREAM_TIMEOUT_MS) {
+        stop();
+    }
+    return active;
+}
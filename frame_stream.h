@@ -0,0 +1,56 @@
+#pragma once
+
+#include "quantum.h"
+
+// Framebuffer streaming. The host renders the whole screen itself and sends
+// only the 8x8 tiles that changed since its last frame, in OLED page order
+// (byte i is column i % 128 of page i / 128). While a stream is running
+// oled_task_user() composes nothing. Stream reports from the host:
+//
+// | FRAME_STREAM | FRAME_OP_START |
+// | FRAME_STREAM | FRAME_OP_RAW | u16 offset | n | n bytes of frame data |
+// | FRAME_STREAM | FRAME_OP_RLE | u16 offset | n | n bytes of RLE data |
+// | FRAME_STREAM | FRAME_OP_END | seq |
+// | FRAME_STREAM | FRAME_OP_STOP |
+//
+// RLE data uses the bitmap_rle.h format and every report decodes on its own.
+// Tiles are staged until FRAME_OP_END and then copied into the OLED buffer
+// together, so a frame is never shown half received. START clears the screen,
+// which is also the host's starting point for its deltas. A stream that goes
+// quiet for FRAME_STREAM_TIMEOUT_MS ends by itself and the layer screen
+// comes back.
+
+// first byte of a stream report, next to IMAGE_UPLOAD
+#define FRAME_STREAM 0xC2
+
+enum frame_ops {
+    FRAME_OP_START = 1,
+    FRAME_OP_RAW = 2,
+    FRAME_OP_RLE = 3,
+    FRAME_OP_END = 4,
+    FRAME_OP_STOP = 5,
+};
+
+#define FRAME_SIZE (OLED_DISPLAY_WIDTH * OLED_DISPLAY_HEIGHT / 8)
+#define FRAME_TILE_SIZE 8
+#define FRAME_TILES (FRAME_SIZE / FRAME_TILE_SIZE)
+
+#ifndef FRAME_STREAM_TIMEOUT_MS
+#    define FRAME_STREAM_TIMEOUT_MS 2000
+#endif
+
+typedef struct {
+    uint16_t frames;       // frames shown in the last RENDER_STATS_MS window
+    uint16_t tiles;        // tiles copied to the OLED buffer in the last window
+    uint32_t bytes;        // stream report bytes received in the last window
+    uint8_t last_seq;      // seq of the last frame shown
+} frame_stream_stats_t;
+
+extern frame_stream_stats_t frame_stream_stats;
+
+// Handles stream reports, returns false for any other report
+bool frame_stream_receive(const uint8_t *data, uint8_t length);
+
+// True while the host owns the screen, call from oled_task_user() before
+// composing anything. Ends a stream that timed out.
+bool frame_stream_active(void);
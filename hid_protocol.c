@@ -0,0 +1,385 @@
+#include "hid_protocol.h"
+#include "text_format.h"
+#include <stddef.h>
+#include <string.h>
+
+// -------------------------------------------------------------------------- //
+// Helpers
+// -------------------------------------------------------------------------- //
+
+static uint16_t read_u16(const uint8_t *buf) {
+    return (uint16_t)buf[0] | ((uint16_t)buf[1] << 8);
+}
+
+static uint32_t read_u32(const uint8_t *buf) {
+    return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) | ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+}
+
+static void copy_text(char *dest, uint8_t dest_size, const uint8_t *src, uint8_t src_len) {
+    uint8_t n = src_len < dest_size - 1 ? src_len : dest_size - 1;
+    memcpy(dest, src, n);
+    dest[n] = '\0';
+}
+
+// -------------------------------------------------------------------------- //
+// Delta decoding
+// -------------------------------------------------------------------------- //
+
+typedef struct {
+    uint8_t offset;
+    uint8_t size;
+} field_t;
+
+typedef struct {
+    const field_t *fields;
+    uint8_t count;
+} field_table_t;
+
+static const field_t pc_fields[] = {
+    { offsetof(provider_state_t, pc.ram), 1 },
+    { offsetof(provider_state_t, pc.cpu), 1 },
+    { offsetof(provider_state_t, pc.battery), 1 },
+};
+
+static const field_t network_fields[] = {
+    { offsetof(provider_state_t, network.state), 1 },
+    { offsetof(provider_state_t, network.elapsed_s), 2 },
+    { offsetof(provider_state_t, network.download_x10), 2 },
+    { offsetof(provider_state_t, network.upload_x10), 2 },
+};
+
+static const field_t timer_fields[] = {
+    { offsetof(provider_state_t, timer.state), 1 },
+    { offsetof(provider_state_t, timer.remaining_s), 4 },
+};
+
+// indexed by the bit position of the provider in provider_flags
+static const field_table_t delta_tables[] = {
+    { pc_fields, sizeof(pc_fields) / sizeof(pc_fields[0]) },
+    { network_fields, sizeof(network_fields) / sizeof(network_fields[0]) },
+    { NULL, 0 }, // song text is never delta encoded
+    { timer_fields, sizeof(timer_fields) / sizeof(timer_fields[0]) },
+};
+
+#define DELTA_PROVIDER_COUNT (sizeof(delta_tables) / sizeof(delta_tables[0]))
+
+static struct {
+    uint8_t expected[DELTA_PROVIDER_COUNT]; // next generation per provider
+    uint8_t synced;                         // provider bits with a keyframe applied
+} delta;
+
+// Applies the masked fields straight into the state struct. Wire order is
+// little endian like the MCU, so every field is a plain copy.
+static uint8_t decode_delta(const uint8_t *value, uint8_t len, provider_state_t *state) {
+    if (len < 3) return 0;
+
+    uint8_t index = value[0];
+    uint8_t generation = value[1];
+    uint8_t mask = value[2];
+    if (index >= DELTA_PROVIDER_COUNT || delta_tables[index].fields == NULL) return 0;
+
+    const field_table_t *table = &delta_tables[index];
+    uint8_t provider = 1 << index;
+    bool keyframe = mask == (1 << table->count) - 1;
+
+    if (!keyframe && (!(delta.synced & provider) || generation != delta.expected[index])) {
+        delta.synced &= ~provider;
+        return KEYFRAME_NEEDED;
+    }
+
+    // check the length before touching state so a bad record changes nothing
+    uint8_t needed = 3;
+    for (uint8_t i = 0; i < table->count; i++) {
+        if (mask & (1 << i)) needed += table->fields[i].size;
+    }
+    if (len < needed) return 0;
+
+    const uint8_t *field_value = value + 3;
+    for (uint8_t i = 0; i < table->count; i++) {
+        if (!(mask & (1 << i))) continue;
+        memcpy((uint8_t *)state + table->fields[i].offset, field_value, table->fields[i].size);
+        field_value += table->fields[i].size;
+    }
+
+    delta.synced |= provider;
+    delta.expected[index] = generation + 1;
+
+    if (provider == PROVIDER_PC) state->pc.valid = true;
+    if (provider == PROVIDER_TIMER) state->timer.valid = true;
+
+    return provider;
+}
+
+// -------------------------------------------------------------------------- //
+// Binary TLV decoding
+// -------------------------------------------------------------------------- //
+
+hid_host_info_t hid_host_info;
+
+static uint8_t decode_record(uint8_t type, const uint8_t *value, uint8_t len, provider_state_t *state) {
+    switch (type) {
+        case TLV_PC_STATS:
+            if (len < 3) return 0;
+            state->pc.ram = value[0];
+            state->pc.cpu = value[1];
+            state->pc.battery = value[2];
+            state->pc.valid = true;
+            return PROVIDER_PC;
+        case TLV_NETWORK:
+            if (len < 7) return 0;
+            state->network.state = value[0];
+            state->network.elapsed_s = read_u16(value + 1);
+            state->network.download_x10 = read_u16(value + 3);
+            state->network.upload_x10 = read_u16(value + 5);
+            return PROVIDER_NETWORK;
+        case TLV_SONG_TITLE:
+            copy_text(state->song.title, SONG_TEXT_SIZE, value, len);
+            state->song.valid = len > 0;
+            return PROVIDER_SONG;
+        case TLV_SONG_ARTIST:
+            copy_text(state->song.artist, SONG_TEXT_SIZE, value, len);
+            return PROVIDER_SONG;
+        case TLV_TIMER:
+            if (len < 5) return 0;
+            state->timer.state = value[0];
+            state->timer.remaining_s = read_u32(value + 1);
+            state->timer.valid = true;
+            return PROVIDER_TIMER;
+        case TLV_SYNC:
+            return HOST_SYNC_REQUEST;
+        case TLV_DELTA:
+            return decode_delta(value, len, state);
+        case TLV_HELLO:
+            if (len < 3) return 0;
+            hid_host_info.version = value[0];
+            hid_host_info.capabilities = read_u16(value + 1);
+            hid_host_info.valid = true;
+            return HOST_HELLO;
+    }
+
+    // unknown records are skipped so newer hosts can add types
+    return 0;
+}
+
+static uint8_t decode_records(const uint8_t *body, uint16_t length, provider_state_t *state) {
+    uint8_t updated = 0;
+    uint16_t pos = 0;
+
+    while (pos + HID_TLV_HEADER_SIZE <= length) {
+        uint8_t type = body[pos];
+        uint8_t len = body[pos + 1];
+
+        if (type == TLV_END) break;
+        if (pos + HID_TLV_HEADER_SIZE + len > length) break; // truncated record
+
+        updated |= decode_record(type, body + pos + HID_TLV_HEADER_SIZE, len, state);
+        pos += HID_TLV_HEADER_SIZE + len;
+    }
+
+    return updated;
+}
+
+// -------------------------------------------------------------------------- //
+// Fragment reassembly
+// -------------------------------------------------------------------------- //
+
+hid_protocol_stats_t hid_protocol_stats;
+
+static struct {
+    uint8_t buffer[HID_MESSAGE_MAX];
+    bool active;
+    uint8_t seq;
+    uint8_t count;
+    uint8_t received; // one bit per fragment index
+} reassembly;
+
+static uint8_t reassemble(const uint8_t *data, uint8_t length, provider_state_t *state) {
+    const uint8_t header_size = HID_PROTO_HEADER_SIZE + HID_FRAGMENT_HEADER_SIZE;
+    if (length < header_size) return 0;
+
+    uint8_t seq = data[2];
+    uint8_t index = data[3];
+    uint8_t count = data[4];
+
+    if (count == 0 || count > HID_MAX_FRAGMENTS || index >= count) return 0;
+
+    // a new sequence number abandons whatever was half received
+    if (!reassembly.active || seq != reassembly.seq || count != reassembly.count) {
+        if (reassembly.active) hid_protocol_stats.messages_dropped++;
+        memset(reassembly.buffer, 0, sizeof(reassembly.buffer));
+        reassembly.active = true;
+        reassembly.seq = seq;
+        reassembly.count = count;
+        reassembly.received = 0;
+    }
+
+    uint8_t slice = length - header_size;
+    if (slice > HID_FRAGMENT_PAYLOAD) slice = HID_FRAGMENT_PAYLOAD;
+    memcpy(reassembly.buffer + index * HID_FRAGMENT_PAYLOAD, data + header_size, slice);
+    reassembly.received |= 1 << index;
+
+    if (reassembly.received != (1 << count) - 1) return MESSAGE_INCOMPLETE;
+
+    reassembly.active = false;
+    hid_protocol_stats.messages++;
+    return decode_records(reassembly.buffer, count * HID_FRAGMENT_PAYLOAD, state);
+}
+
+static uint8_t decode_tlv(const uint8_t *data, uint8_t length, provider_state_t *state) {
+    if ((data[0] & 0x0F) != HID_PROTO_VERSION) return 0;
+    if (length < HID_PROTO_HEADER_SIZE) return 0;
+
+    if (data[1] & HID_FLAG_FRAGMENT) {
+        return reassemble(data, length, state);
+    }
+
+    return decode_records(data + HID_PROTO_HEADER_SIZE, length - HID_PROTO_HEADER_SIZE, state);
+}
+
+// -------------------------------------------------------------------------- //
+// Legacy ASCII decoding
+// -------------------------------------------------------------------------- //
+
+// Copies the next '|' separated field into out and advances the cursor past it
+static void next_field(const char **cursor, char *out, uint8_t out_size) {
+    uint8_t n = 0;
+    while (**cursor != '\0' && **cursor != '|') {
+        if (n < out_size - 1) out[n++] = **cursor;
+        (*cursor)++;
+    }
+    if (**cursor == '|') (*cursor)++;
+    out[n] = '\0';
+}
+
+static uint8_t decode_legacy(const uint8_t *data, uint8_t length, provider_state_t *state) {
+    char text[HID_REPORT_SIZE + 1];
+    uint8_t n = length < HID_REPORT_SIZE ? length : HID_REPORT_SIZE;
+    memcpy(text, data, n);
+    text[n] = '\0';
+
+    const char *cursor = text + 1;
+    char first[SONG_TEXT_SIZE];
+    char second[SONG_TEXT_SIZE];
+    next_field(&cursor, first, sizeof(first));
+    next_field(&cursor, second, sizeof(second));
+
+    switch (text[0] - '0') {
+        case PC_PERFORMANCE: {
+            char third[8];
+            uint32_t ram = 0, cpu = 0, bat = 0;
+            next_field(&cursor, third, sizeof(third));
+            state->pc.valid = parse_uint(first, &ram) && parse_uint(second, &cpu);
+            parse_uint(third, &bat);
+            state->pc.ram = ram;
+            state->pc.cpu = cpu;
+            state->pc.battery = bat;
+            return PROVIDER_PC;
+        }
+        case NETWORK_TEST: {
+            uint32_t elapsed = 0;
+            if (strcmp(first, "testing") == 0) {
+                parse_uint(second, &elapsed);
+                state->network.state = NETWORK_TESTING;
+                state->network.elapsed_s = elapsed;
+            } else if (strcmp(first, "--") != 0 && strcmp(second, "--") != 0) {
+                state->network.state = NETWORK_COMPLETED;
+                state->network.download_x10 = parse_fixed_x10(first);
+                state->network.upload_x10 = parse_fixed_x10(second);
+            } else {
+                state->network.state = NETWORK_IDLE;
+            }
+            return PROVIDER_NETWORK;
+        }
+        case CURRENT_SONG:
+            state->song.valid = first[0] != '\0' && strcmp(first, "--") != 0;
+            strcpy(state->song.title, first);
+            strcpy(state->song.artist, second);
+            return PROVIDER_SONG;
+        case TIMER_STATUS:
+            if (strcmp(first, "COMPLETED") == 0) {
+                state->timer.state = TIMER_STATE_COMPLETED;
+            } else if (strcmp(first, "PAUSED") == 0) {
+                state->timer.state = TIMER_STATE_PAUSED;
+            } else if (strcmp(first, "RUNNING") == 0) {
+                state->timer.state = TIMER_STATE_RUNNING;
+            } else {
+                state->timer.state = TIMER_STATE_STOPPED;
+            }
+            state->timer.remaining_s = parse_hms(second);
+            state->timer.valid = true;
+            return PROVIDER_TIMER;
+    }
+
+    return 0;
+}
+
+// -------------------------------------------------------------------------- //
+// Public API
+// -------------------------------------------------------------------------- //
+
+uint8_t hid_protocol_decode(const uint8_t *data, uint8_t length, provider_state_t *state) {
+    if (length == 0) return 0;
+
+    if ((data[0] & HID_PROTO_MAGIC_MASK) == HID_PROTO_MAGIC) {
+        return decode_tlv(data, length, state);
+    }
+
+    if (data[0] >= '0' && data[0] <= '9') {
+        return decode_legacy(data, length, state);
+    }
+
+    return 0;
+}
+
+uint8_t hid_protocol_flags(const uint8_t *data, uint8_t length) {
+    if (length < HID_PROTO_HEADER_SIZE) return 0;
+    if ((data[0] & HID_PROTO_MAGIC_MASK) != HID_PROTO_MAGIC) return 0;
+    return data[1];
+}
+
+void hid_protocol_write_hello(uint8_t *buffer, const hid_hello_t *hello) {
+    memset(buffer, 0, HID_REPORT_SIZE);
+
+    buffer[0] = HELLO;
+    buffer[1] = HID_PROTO_VERSION;
+    buffer[2] = HID_FIRMWARE_CAPS & 0xFF;
+    buffer[3] = HID_FIRMWARE_CAPS >> 8;
+    buffer[4] = HID_REPORT_SIZE;
+    buffer[5] = hello->screen_lines;
+    buffer[6] = hello->screen_columns;
+    buffer[7] = hello->providers;
+
+    uint8_t pos = 9;
+    uint8_t count = 0;
+    while (count < hello->layer_count && pos < HID_REPORT_SIZE - 1) {
+        buffer[pos++] = hello->layer_kinds[count++];
+    }
+    buffer[8] = count;
+
+    // the variant name takes whatever is left, always NUL terminated
+    for (const char *c = hello->variant; *c && pos < HID_REPORT_SIZE - 1; c++) {
+        buffer[pos++] = *c;
+    }
+}
+
+void hid_protocol_write_rgb(uint8_t *buffer, uint8_t value, uint8_t hue, uint8_t sat, uint8_t val) {
+    static uint16_t seq = 0;
+
+    seq++;
+    uint32_t now = timer_read32();
+
+    memset(buffer, 0, HID_REPORT_SIZE);
+
+    buffer[0] = RGB_SEND;
+    buffer[1] = value;
+    buffer[2] = seq & 0xFF;
+    buffer[3] = seq >> 8;
+    buffer[4] = now & 0xFF;
+    buffer[5] = (now >> 8) & 0xFF;
+    buffer[6] = (now >> 16) & 0xFF;
+    buffer[7] = now >> 24;
+    buffer[8] = RGB_HSV_PRESENT;
+    buffer[9] = hue;
+    buffer[10] = sat;
+    buffer[11] = val;
+}
@@ -0,0 +1,226 @@
+#pragma once
+
+#include "quantum.h"
+
+// -------------------------------------------------------------------------- //
+// Wire format
+// -------------------------------------------------------------------------- //
+
+// Binary reports start with a magic nibble plus the protocol version, followed
+// by a flags byte and a list of type/length/value records. Legacy reports start
+// with an ASCII digit so the two framings never collide.
+//
+// | 0xB0 + version (byte 0) | flags (byte 1) | type | len | value ... | type | len | value ... |
+//
+// Messages too large for one report set HID_FLAG_FRAGMENT and are split into
+// up to HID_MAX_FRAGMENTS reports that share a sequence number:
+//
+// | 0xB0 + version (byte 0) | flags (byte 1) | seq | index | count | slice of the records ... |
+
+#define HID_REPORT_SIZE 32
+
+#define HID_PROTO_MAGIC 0xB0
+#define HID_PROTO_MAGIC_MASK 0xF0
+#define HID_PROTO_VERSION 1
+#define HID_PROTO_HEADER_SIZE 2
+
+// header flags
+#define HID_FLAG_EVENT_MODE (1 << 0) // host pushes updates, firmware sends requests unsolicited
+#define HID_FLAG_FRAGMENT (1 << 1)   // report carries one slice of a larger message
+
+#define HID_FRAGMENT_HEADER_SIZE 3
+#define HID_FRAGMENT_PAYLOAD (HID_REPORT_SIZE - HID_PROTO_HEADER_SIZE - HID_FRAGMENT_HEADER_SIZE)
+#define HID_MAX_FRAGMENTS 6
+#define HID_MESSAGE_MAX (HID_FRAGMENT_PAYLOAD * HID_MAX_FRAGMENTS)
+
+// record header is one type byte and one length byte
+#define HID_TLV_HEADER_SIZE 2
+
+enum hid_tlv_types {
+    TLV_END = 0,         // padding, stops decoding
+    TLV_PC_STATS = 1,    // u8 ram %, u8 cpu %, u8 battery %
+    TLV_NETWORK = 2,     // u8 state, u16 elapsed s, u16 download Mbps x10, u16 upload Mbps x10
+    TLV_SONG_TITLE = 3,  // utf-8 text, not NUL terminated
+    TLV_SONG_ARTIST = 4, // utf-8 text, not NUL terminated
+    TLV_TIMER = 5,       // u8 state, u32 remaining s
+    TLV_SYNC = 6,        // empty, asks the firmware to resend its subscription
+    TLV_DELTA = 7,       // u8 provider index, u8 generation, u8 field mask, changed fields
+    TLV_HELLO = 8,       // u8 host protocol version, u16 host capabilities
+};
+
+// A delta carries only the fields whose bit is set in its mask, in field order
+// and with the same widths as the full record. Every delta of a provider bumps
+// its generation; a delta with every field set is a keyframe and resyncs the
+// generation. Song text is always sent as full records.
+
+// Request ids sent by the firmware as the first byte of a report. Legacy host
+// replies reuse them as an ASCII digit to tag their payload.
+enum PC_req_types {
+    PC_PERFORMANCE = 1,
+    NETWORK_TEST = 2,
+    CURRENT_SONG = 3,
+    REQUEST_RETEST = 4,
+    RGB_SEND = 5,      // see hid_protocol_write_rgb()
+    TIMER_STATUS = 6,
+    TIMER_PAUSE_REQ = 7,
+    TIMER_RESTART_REQ = 8,
+    TIMER_RESET_REQ = 9,
+    SUBSCRIBE = 10,    // event mode only, second byte is the provider_flags shown on screen
+    KEYFRAME_REQ = 11, // a delta generation was skipped, host resends full state
+    HELLO = 12,        // answer to TLV_HELLO, see hid_protocol_write_hello()
+    IMAGE_STATUS = 13, // answer to an image upload, see image_slots.h
+};
+
+// -------------------------------------------------------------------------- //
+// Handshake
+// -------------------------------------------------------------------------- //
+
+// The host opens every connection with a TLV_HELLO record and the firmware
+// answers with a HELLO report describing itself:
+//
+// | HELLO | version | caps lo | caps hi | report size | lines | columns |
+// | providers | layer count | layer kinds ... | variant name, NUL terminated |
+//
+// Firmware that predates the handshake answers with an ordinary request,
+// which tells the host to fall back to the legacy ASCII reports.
+
+enum hid_capabilities {
+    CAP_TLV = 1 << 0,
+    CAP_EVENT_MODE = 1 << 1,
+    CAP_FRAGMENTS = 1 << 2,
+    CAP_DELTA = 1 << 3,
+    CAP_IMAGE_SLOTS = 1 << 4,
+    CAP_FRAME_STREAM = 1 << 5,
+};
+
+#define HID_FIRMWARE_CAPS (CAP_TLV | CAP_EVENT_MODE | CAP_FRAGMENTS | CAP_DELTA | CAP_IMAGE_SLOTS | CAP_FRAME_STREAM)
+
+// what each layer is for, so the host can tell builds apart
+enum layer_kinds {
+    LAYER_KIND_HOME = 1,
+    LAYER_KIND_PROGRAMMING = 2,
+    LAYER_KIND_GIT = 3,
+    LAYER_KIND_MARKDOWN = 4,
+    LAYER_KIND_NETWORK = 5,
+    LAYER_KIND_MEDIA = 6,
+    LAYER_KIND_POMODORO = 7,
+    LAYER_KIND_ARROWS = 8,
+    LAYER_KIND_NVIM = 9,
+};
+
+typedef struct {
+    uint8_t screen_lines;
+    uint8_t screen_columns;
+    uint8_t providers; // provider_flags shown on any layer
+    uint8_t layer_count;
+    const uint8_t *layer_kinds;
+    const char *variant;
+} hid_hello_t;
+
+typedef struct {
+    bool valid;
+    uint8_t version;
+    uint16_t capabilities;
+} hid_host_info_t;
+
+// filled in from the host's TLV_HELLO
+extern hid_host_info_t hid_host_info;
+
+// -------------------------------------------------------------------------- //
+// Decoded provider state
+// -------------------------------------------------------------------------- //
+
+enum network_states {
+    NETWORK_NO_DATA,
+    NETWORK_IDLE,
+    NETWORK_TESTING,
+    NETWORK_COMPLETED,
+};
+
+enum timer_states {
+    TIMER_STATE_STOPPED,
+    TIMER_STATE_RUNNING,
+    TIMER_STATE_PAUSED,
+    TIMER_STATE_COMPLETED,
+};
+
+// bits returned by hid_protocol_decode() for every provider that was updated
+enum provider_flags {
+    PROVIDER_PC = 1 << 0,
+    PROVIDER_NETWORK = 1 << 1,
+    PROVIDER_SONG = 1 << 2,
+    PROVIDER_TIMER = 1 << 3,
+    HOST_HELLO = 1 << 4,         // not a provider, the host opened a connection
+    KEYFRAME_NEEDED = 1 << 5,    // not a provider, a delta arrived out of sequence
+    MESSAGE_INCOMPLETE = 1 << 6, // not a provider, fragment stored until the rest arrives
+    HOST_SYNC_REQUEST = 1 << 7,  // not a provider, set when the host sent TLV_SYNC
+};
+
+#define SONG_TEXT_SIZE 64
+
+typedef struct {
+    bool valid;
+    uint8_t ram;
+    uint8_t cpu;
+    uint8_t battery;
+} pc_stats_t;
+
+typedef struct {
+    uint8_t state;
+    uint16_t elapsed_s;
+    uint16_t download_x10;
+    uint16_t upload_x10;
+} network_stats_t;
+
+typedef struct {
+    bool valid;
+    char title[SONG_TEXT_SIZE];
+    char artist[SONG_TEXT_SIZE];
+} song_info_t;
+
+typedef struct {
+    bool valid;
+    uint8_t state;
+    uint32_t remaining_s;
+} timer_info_t;
+
+typedef struct {
+    uint16_t messages;         // fragmented messages reassembled
+    uint16_t messages_dropped; // fragmented messages abandoned before completion
+} hid_protocol_stats_t;
+
+extern hid_protocol_stats_t hid_protocol_stats;
+
+typedef struct {
+    pc_stats_t pc;
+    network_stats_t network;
+    song_info_t song;
+    timer_info_t timer;
+} provider_state_t;
+
+// Decodes one report from the host into state. Accepts both the binary TLV
+// framing and the legacy "digit + pipe-delimited" ASCII framing. Fragments are
+// copied into a bounded reassembly buffer and decoded once the last one arrives.
+// Returns a mask of provider_flags for the providers that were updated.
+uint8_t hid_protocol_decode(const uint8_t *data, uint8_t length, provider_state_t *state);
+
+// Header flags of a binary report, 0 for legacy reports
+uint8_t hid_protocol_flags(const uint8_t *data, uint8_t length);
+
+// Writes the HELLO report into buffer, which must be HID_REPORT_SIZE bytes
+void hid_protocol_write_hello(uint8_t *buffer, const hid_hello_t *hello);
+
+// marks an RGB_SEND that carries the colour, older firmware leaves it 0
+#define RGB_HSV_PRESENT 0x01
+
+// Writes an RGB_SEND report into buffer, which must be HID_REPORT_SIZE bytes:
+//
+// | RGB_SEND | layer or colour | u16 sequence | u32 timer_read32() at send |
+// | RGB_HSV_PRESENT | hue | sat | val |
+//
+// The host forwards everything after the layer byte to the keyboard untouched.
+// The keyboard applies the HSV colour, and only falls back to its own table
+// of layer colours for macropads that don't send one. Keyboard firmware built
+// with RGB_RECEIPT_ENABLE echoes the sequence and timestamp back, which is how
+// macropad_benchmark.py times the hops of a layer change.
+void hid_protocol_write_rgb(uint8_t *buffer, uint8_t value, uint8_t hue, uint8_t sat, uint8_t val);
@@ -0,0 +1,293 @@
+#include "image_slots.h"
+#include "bitmap_rle.h"
+#include "hid_protocol.h"
+#include "oled_render.h"
+#include "raw_hid.h"
+#include <string.h>
+
+#define IMAGE_SLOT_MAGIC 0xA5
+
+#ifdef EECONFIG_USER_DATA_SIZE
+_Static_assert(EECONFIG_USER_DATA_SIZE >= IMAGE_SLOT_COUNT * IMAGE_SLOT_SIZE,
+               "EECONFIG_USER_DATA_SIZE is too small for IMAGE_SLOT_COUNT image slots");
+#endif
+
+_Static_assert(IMAGE_SLOT_COUNT <= 8, "the valid slot mask is one byte");
+
+enum upload_states {
+    UPLOAD_IDLE,
+    UPLOAD_RECEIVING,
+    UPLOAD_WRITING,
+    UPLOAD_VERIFYING,
+};
+
+static struct {
+    uint8_t state;
+    uint8_t slot;
+    uint16_t length;
+    uint16_t crc;
+    uint16_t progress; // bytes received, written or verified
+    uint16_t verify_crc;
+    uint8_t data[IMAGE_SLOT_DATA_SIZE];
+} upload;
+
+static uint8_t valid_slots = 0;
+
+// unpacked, so drawing it never reads past what the host sent
+static uint8_t album_art[BITMAP_SIZE];
+static bool album_art_valid = false;
+
+static uint8_t *slot_address(uint8_t slot) {
+    return IMAGE_SLOTS_EEPROM_ADDR + (uint16_t)slot * IMAGE_SLOT_SIZE;
+}
+
+static uint16_t read_u16(const uint8_t *buf) {
+    return (uint16_t)buf[0] | ((uint16_t)buf[1] << 8);
+}
+
+uint16_t image_crc16(uint16_t crc, const uint8_t *data, uint16_t length) {
+    while (length--) {
+        crc ^= (uint16_t)*data++ << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static void send_status(uint8_t slot, uint8_t status, uint16_t bytes) {
+    uint8_t buffer[HID_REPORT_SIZE];
+    memset(buffer, 0, HID_REPORT_SIZE);
+
+    buffer[0] = IMAGE_STATUS;
+    buffer[1] = slot;
+    buffer[2] = status;
+    buffer[3] = IMAGE_SLOT_COUNT;
+    buffer[4] = valid_slots;
+    buffer[5] = bytes & 0xFF;
+    buffer[6] = bytes >> 8;
+
+    raw_hid_send(buffer, HID_REPORT_SIZE);
+}
+
+// Reads the slot back in chunks, true if it matches its header
+static bool check_slot(uint8_t slot) {
+    uint8_t header[IMAGE_SLOT_HEADER_SIZE];
+    eeprom_read_block(header, slot_address(slot), sizeof(header));
+
+    uint16_t length = read_u16(header + 1);
+    if (header[0] != IMAGE_SLOT_MAGIC || length == 0 || length > IMAGE_SLOT_DATA_SIZE) {
+        return false;
+    }
+
+    uint8_t chunk[IMAGE_WRITE_CHUNK];
+    uint16_t crc = 0xFFFF;
+    for (uint16_t pos = 0; pos < length; pos += IMAGE_WRITE_CHUNK) {
+        uint16_t n = length - pos < IMAGE_WRITE_CHUNK ? length - pos : IMAGE_WRITE_CHUNK;
+        eeprom_read_block(chunk, slot_address(slot) + IMAGE_SLOT_HEADER_SIZE + pos, n);
+        crc = image_crc16(crc, chunk, n);
+    }
+
+    return crc == read_u16(header + 3);
+}
+
+void image_slots_init(void) {
+    valid_slots = 0;
+    for (uint8_t slot = 0; slot < IMAGE_SLOT_COUNT; slot++) {
+        if (check_slot(slot)) valid_slots |= 1 << slot;
+    }
+}
+
+static void invalidate_slot(uint8_t slot) {
+    valid_slots &= ~(1 << slot);
+    eeprom_update_byte(slot_address(slot), 0);
+}
+
+static void handle_begin(const uint8_t *data) {
+    uint8_t slot = data[2];
+    uint16_t image_length = read_u16(data + 3);
+
+    if (upload.state == UPLOAD_WRITING || upload.state == UPLOAD_VERIFYING) {
+        send_status(slot, IMAGE_ERR_BUSY, 0);
+    } else if (slot >= IMAGE_SLOT_COUNT && slot != IMAGE_SLOT_ALBUM_ART) {
+        send_status(slot, IMAGE_ERR_SLOT, 0);
+    } else if (image_length == 0 || image_length > IMAGE_SLOT_DATA_SIZE) {
+        send_status(slot, IMAGE_ERR_LENGTH, 0);
+    } else {
+        upload.state = UPLOAD_RECEIVING;
+        upload.slot = slot;
+        upload.length = image_length;
+        upload.crc = read_u16(data + 5);
+        upload.progress = 0;
+        send_status(slot, IMAGE_OK, 0);
+    }
+}
+
+// Not answered, a gap or overrun is reported when the host commits
+static void handle_data(const uint8_t *data, uint8_t length) {
+    if (upload.state != UPLOAD_RECEIVING) return;
+
+    uint16_t offset = read_u16(data + 2);
+    uint8_t n = data[4];
+
+    if (offset != upload.progress || n > length - 5 || offset + n > upload.length) {
+        upload.state = UPLOAD_IDLE;
+        return;
+    }
+
+    memcpy(upload.data + offset, data + 5, n);
+    upload.progress += n;
+}
+
+static void handle_commit(void) {
+    if (upload.state != UPLOAD_RECEIVING || upload.progress != upload.length) {
+        if (upload.state == UPLOAD_WRITING || upload.state == UPLOAD_VERIFYING) {
+            send_status(upload.slot, IMAGE_ERR_BUSY, 0);
+            return;
+        }
+        upload.state = UPLOAD_IDLE;
+        send_status(upload.slot, IMAGE_ERR_SEQUENCE, upload.progress);
+        return;
+    }
+
+    if (image_crc16(0xFFFF, upload.data, upload.length) != upload.crc) {
+        upload.state = UPLOAD_IDLE;
+        send_status(upload.slot, IMAGE_ERR_CRC, upload.progress);
+        return;
+    }
+
+    // a stream that runs out early would be drawn from whatever follows it
+    if (bitmap_rle_unpack(upload.data, upload.length, NULL, BITMAP_SIZE) != BITMAP_SIZE) {
+        upload.state = UPLOAD_IDLE;
+        send_status(upload.slot, IMAGE_ERR_LENGTH, upload.progress);
+        return;
+    }
+
+    if (upload.slot == IMAGE_SLOT_ALBUM_ART) {
+        upload.state = UPLOAD_IDLE;
+        bitmap_rle_unpack(upload.data, upload.length, album_art, BITMAP_SIZE);
+        album_art_valid = true;
+        render_invalidate();
+        send_status(upload.slot, IMAGE_OK, upload.length);
+        return;
+    }
+
+    // the header goes in last, so a half written slot is never shown
+    invalidate_slot(upload.slot);
+    upload.state = UPLOAD_WRITING;
+    upload.progress = 0;
+}
+
+static void handle_erase(const uint8_t *data) {
+    uint8_t slot = data[2];
+
+    if (upload.state == UPLOAD_WRITING || upload.state == UPLOAD_VERIFYING) {
+        send_status(slot, IMAGE_ERR_BUSY, 0);
+    } else if (slot == IMAGE_SLOT_ALBUM_ART) {
+        album_art_valid = false;
+        render_invalidate();
+        send_status(slot, IMAGE_OK, 0);
+    } else if (slot >= IMAGE_SLOT_COUNT) {
+        send_status(slot, IMAGE_ERR_SLOT, 0);
+    } else {
+        invalidate_slot(slot);
+        send_status(slot, IMAGE_OK, 0);
+    }
+}
+
+bool image_slots_receive(const uint8_t *data, uint8_t length) {
+    if (length < 2 || data[0] != IMAGE_UPLOAD) return false;
+
+    switch (data[1]) {
+        case IMAGE_OP_BEGIN:
+            if (length >= 7) handle_begin(data);
+            break;
+        case IMAGE_OP_DATA:
+            if (length >= 5) handle_data(data, length);
+            break;
+        case IMAGE_OP_COMMIT:
+            handle_commit();
+            break;
+        case IMAGE_OP_ERASE:
+            if (length >= 3) handle_erase(data);
+            break;
+    }
+
+    return true;
+}
+
+void image_slots_task(void) {
+    uint8_t *address = slot_address(upload.slot);
+    uint16_t remaining = upload.length - upload.progress;
+    uint16_t n = remaining < IMAGE_WRITE_CHUNK ? remaining : IMAGE_WRITE_CHUNK;
+
+    if (upload.state == UPLOAD_WRITING) {
+        eeprom_update_block(upload.data + upload.progress, address + IMAGE_SLOT_HEADER_SIZE + upload.progress, n);
+        upload.progress += n;
+
+        if (upload.progress == upload.length) {
+            upload.state = UPLOAD_VERIFYING;
+            upload.progress = 0;
+            upload.verify_crc = 0xFFFF;
+        }
+    } else if (upload.state == UPLOAD_VERIFYING) {
+        uint8_t chunk[IMAGE_WRITE_CHUNK];
+        eeprom_read_block(chunk, address + IMAGE_SLOT_HEADER_SIZE + upload.progress, n);
+        upload.verify_crc = image_crc16(upload.verify_crc, chunk, n);
+        upload.progress += n;
+
+        if (upload.progress < upload.length) return;
+
+        upload.state = UPLOAD_IDLE;
+        if (upload.verify_crc != upload.crc) {
+            send_status(upload.slot, IMAGE_ERR_VERIFY, upload.length);
+            return;
+        }
+
+        uint8_t header[IMAGE_SLOT_HEADER_SIZE] = {
+            IMAGE_SLOT_MAGIC,
+            upload.length & 0xFF,
+            upload.length >> 8,
+            upload.crc & 0xFF,
+            upload.crc >> 8,
+        };
+        eeprom_update_block(header, address, sizeof(header));
+        valid_slots |= 1 << upload.slot;
+        send_status(upload.slot, IMAGE_OK, upload.length);
+    }
+}
+
+uint8_t image_slots_available(void) {
+    uint8_t count = 0;
+    for (uint8_t slot = 0; slot < IMAGE_SLOT_COUNT; slot++) {
+        if (valid_slots & (1 << slot)) count++;
+    }
+    return count;
+}
+
+static uint8_t read_eeprom(const uint8_t *address) {
+    return eeprom_read_byte(address);
+}
+
+void image_slots_draw(uint8_t index) {
+    for (uint8_t slot = 0; slot < IMAGE_SLOT_COUNT; slot++) {
+        if (!(valid_slots & (1 << slot))) continue;
+        if (index-- == 0) {
+            // the slot's data ends at the length the upload was checked with
+            uint8_t header[IMAGE_SLOT_HEADER_SIZE];
+            eeprom_read_block(header, slot_address(slot), sizeof(header));
+            bitmap_rle_draw_with(read_eeprom, slot_address(slot) + IMAGE_SLOT_HEADER_SIZE, read_u16(header + 1), BITMAP_SIZE);
+            return;
+        }
+    }
+}
+
+bool image_slots_album_art(void) {
+    return album_art_valid;
+}
+
+void image_slots_draw_album_art(void) {
+    for (uint16_t i = 0; i < BITMAP_SIZE; i++) {
+        oled_write_raw_byte(album_art[i], i);
+    }
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "quantum.h"
+#include "bitmaps.h"
+
+// Arrows layer images uploaded over raw HID (macropad_bitmaps.py upload) and
+// kept in EEPROM slots, so they can change without reflashing. Slot data is
+// RLE compressed like bitmaps.c. Upload reports from the host:
+//
+// | IMAGE_UPLOAD | IMAGE_OP_BEGIN | slot | u16 length | u16 crc16 |
+// | IMAGE_UPLOAD | IMAGE_OP_DATA | u16 offset | n | n bytes of data |
+// | IMAGE_UPLOAD | IMAGE_OP_COMMIT |
+// | IMAGE_UPLOAD | IMAGE_OP_ERASE | slot |
+//
+// Data is collected in RAM and checked on COMMIT against the crc, and by a
+// dry run decode that must give a whole image within the length. The slot is
+// then written to EEPROM IMAGE_WRITE_CHUNK bytes per image_slots_task() call,
+// read back and checked again, so key scanning never waits on a whole image.
+// BEGIN, COMMIT and ERASE are each answered with one report, COMMIT once the
+// slot is verified:
+//
+// | IMAGE_STATUS | slot | image_status | slot count | valid slot mask | u16 bytes |
+//
+// IMAGE_SLOT_ALBUM_ART takes the same upload but is only kept in RAM, since
+// it changes with every song. It is unpacked on COMMIT and answered straight
+// away.
+
+// first byte of an upload report, outside both the TLV magic and ASCII digits
+#define IMAGE_UPLOAD 0xC1
+
+enum image_ops {
+    IMAGE_OP_BEGIN = 1,
+    IMAGE_OP_DATA = 2,
+    IMAGE_OP_COMMIT = 3,
+    IMAGE_OP_ERASE = 4,
+};
+
+enum image_status {
+    IMAGE_OK = 0,
+    IMAGE_ERR_SLOT = 1,       // no such slot
+    IMAGE_ERR_LENGTH = 2,     // empty, larger than IMAGE_SLOT_DATA_SIZE or not a whole image
+    IMAGE_ERR_BUSY = 3,       // the previous image is still being written
+    IMAGE_ERR_SEQUENCE = 4,   // DATA or COMMIT without BEGIN, or a gap in the data
+    IMAGE_ERR_CRC = 5,        // received data doesn't match the crc
+    IMAGE_ERR_VERIFY = 6,     // EEPROM read back doesn't match the crc
+};
+
+// the media layer's cover art, see macropad_album_art.py
+#define IMAGE_SLOT_ALBUM_ART 0xFF
+
+#ifndef IMAGE_SLOT_COUNT
+#    define IMAGE_SLOT_COUNT 4
+#endif
+
+#ifndef IMAGE_WRITE_CHUNK
+#    define IMAGE_WRITE_CHUNK 16
+#endif
+
+// any image fits stored as plain literal runs, one control byte per 64 bytes
+#define IMAGE_SLOT_DATA_SIZE (BITMAP_SIZE + BITMAP_SIZE / 64)
+
+// magic, u16 length, u16 crc, then the data
+#define IMAGE_SLOT_HEADER_SIZE 5
+#define IMAGE_SLOT_SIZE (IMAGE_SLOT_HEADER_SIZE + IMAGE_SLOT_DATA_SIZE)
+
+// the keymap's config.h reserves EECONFIG_USER_DATA_SIZE for the slots
+#ifndef IMAGE_SLOTS_EEPROM_ADDR
+#    define IMAGE_SLOTS_EEPROM_ADDR ((uint8_t *)EECONFIG_USER_DATABLOCK)
+#endif
+
+// Checks every slot, call once from keyboard_post_init_user()
+void image_slots_init(void);
+
+// Handles upload reports, returns false for any other report
+bool image_slots_receive(const uint8_t *data, uint8_t length);
+
+// Call from matrix_scan_user()
+void image_slots_task(void);
+
+// Number of slots holding a verified image
+uint8_t image_slots_available(void);
+
+// Draws the index-th verified image into the OLED buffer like bitmap_rle_draw()
+void image_slots_draw(uint8_t index);
+
+// True while the host has sent cover art for the current song
+bool image_slots_album_art(void);
+
+// Draws the cover art into the OLED buffer, for render_raw()
+void image_slots_draw_album_art(void);
+
+// CRC-16/CCITT-FALSE, also computed by the host
+uint16_t image_crc16(uint16_t crc, const uint8_t *data, uint16_t length);
@@ -1,2 +1,5 @@
 #define RAW_USAGE_PAGE 0xFF60
-#define RAW_USAGE_ID 0x61
\ No newline at end of file
+#define RAW_USAGE_ID 0x61
+
+// echo a receipt for every colour change, for macropad_benchmark.py
+// #define RGB_RECEIPT_ENABLE
\ No newline at end of file
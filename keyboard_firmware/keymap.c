@@ -1,11 +1,13 @@
 #include QMK_KEYBOARD_H
 #include "raw_hid.h"
 #include <stdbool.h>
+#include <string.h>
 
 // -------------------------------------------------------------------------- //
 // Declarations and Globals
 // -------------------------------------------------------------------------- //
 
+// only used for macropad firmware that doesn't send the layer's colour
 const hsv_t colour_map[] = {
     { HSV_RED },
     { HSV_BLUE },
@@ -25,12 +27,33 @@ enum custom_keycodes {
 bool rgb_on = true;
 bool fixed_red = false;
 
+// last colour given to rgblight, repeats are skipped
+hsv_t shown_colour;
+
 #define COLOUR_MAP_SIZE (sizeof(colour_map) / sizeof(colour_map[0]))
 
+#define RAW_REPORT_SIZE 32
+
+// first byte of the receipt echoed in benchmark builds, see send_receipt()
+#define RGB_RECEIPT 0xEC
+
+// data[7] when data[8..10] hold the layer's HSV colour (hid_protocol_write_rgb)
+#define RGB_HSV_PRESENT 0x01
+
 // -------------------------------------------------------------------------- //
 // Custom Key Handlers
 // -------------------------------------------------------------------------- //
 
+// Colours follow the macropad's layer, so they aren't saved to EEPROM. Only
+// the RGB toggle is, as an explicit user setting.
+void set_colour(hsv_t colour) {
+    if (colour.h == shown_colour.h && colour.s == shown_colour.s && colour.v == shown_colour.v) {
+        return;
+    }
+    shown_colour = colour;
+    rgblight_sethsv_noeeprom(colour.h, colour.s, colour.v);
+}
+
 void handle_rgb_toggle(keyrecord_t *record) {
     if (record -> event.pressed) {
         if (rgb_on) {
@@ -45,24 +68,51 @@ void handle_rgb_toggle(keyrecord_t *record) {
 void handle_set_rgb_red(keyrecord_t *record) {
     if (record -> event.pressed) {
         if (!fixed_red) {
-            rgblight_sethsv(HSV_RED);
+            set_colour((hsv_t){HSV_RED});
             fixed_red = true;
         } else {
-            rgblight_sethsv(HSV_BLUE);
+            set_colour((hsv_t){HSV_BLUE});
             fixed_red = false;
         }
     }
 }
 
 
+// -------------------------------------------------------------------------- //
+// Latency Receipts
+// -------------------------------------------------------------------------- //
+
+#ifdef RGB_RECEIPT_ENABLE
+// Echoes the layer and the macropad's sequence + timestamp (forwarded by the
+// host after the layer byte) once the colour is applied, followed by this
+// keyboard's own timer. Used by macropad_benchmark.py.
+void send_receipt(uint8_t *data, uint8_t length) {
+    uint8_t receipt[RAW_REPORT_SIZE] = {0};
+    uint8_t echoed = length < 7 ? length : 7;
+
+    receipt[0] = RGB_RECEIPT;
+    memcpy(&receipt[1], data, echoed);
+
+    uint32_t now = timer_read32();
+    receipt[8] = now & 0xFF;
+    receipt[9] = (now >> 8) & 0xFF;
+    receipt[10] = (now >> 16) & 0xFF;
+    receipt[11] = now >> 24;
+
+    raw_hid_send(receipt, RAW_REPORT_SIZE);
+}
+#endif
+
+
 // -------------------------------------------------------------------------- //
 // QMK Override Functions
 // -------------------------------------------------------------------------- //
 
 void keyboard_post_init_user(void) {
-    rgblight_enable();
-    rgblight_mode(RGBLIGHT_MODE_STATIC_LIGHT);
-    rgblight_sethsv(HSV_BLUE);
+    rgb_on = rgblight_is_enabled();
+    rgblight_mode_noeeprom(RGBLIGHT_MODE_STATIC_LIGHT);
+    shown_colour = (hsv_t){HSV_BLUE};
+    rgblight_sethsv_noeeprom(HSV_BLUE);
 }
 
 void raw_hid_receive(uint8_t *data, uint8_t length) {
@@ -80,16 +130,26 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
     print("RECEIVED ON KEYBOARD\n");
     
     uint8_t layer_num = data[0];
-    
-    if (layer_num >= COLOUR_MAP_SIZE) {
-        printf("KEYBOARD: Invalid layer %d (max: %d)\n", layer_num, COLOUR_MAP_SIZE - 1);
-        return;
+    hsv_t colour_struct;
+
+    if (length > 10 && data[7] == RGB_HSV_PRESENT) {
+        colour_struct.h = data[8];
+        colour_struct.s = data[9];
+        colour_struct.v = data[10];
+    } else {
+        if (layer_num >= COLOUR_MAP_SIZE) {
+            printf("KEYBOARD: Invalid layer %d (max: %d)\n", layer_num, COLOUR_MAP_SIZE - 1);
+            return;
+        }
+        colour_struct = colour_map[layer_num];
     }
-    
-    hsv_t colour_struct = colour_map[layer_num];
     printf("KEYBOARD: Setting RGB to layer %d\n", layer_num);
     
-    rgblight_sethsv(colour_struct.h, colour_struct.s, colour_struct.v);
+    set_colour(colour_struct);
+
+#ifdef RGB_RECEIPT_ENABLE
+    send_receipt(data, length);
+#endif
 }
 
 
@@ -1,5 +1,4 @@
 #include QMK_KEYBOARD_H
-#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
@@ -8,6 +7,18 @@
 #include "print.h"
 
 #include "bitmaps.h"
+#include "bitmap_rle.h"
+#include "image_slots.h"
+#include "frame_stream.h"
+#include "hid_protocol.h"
+#include "req_scheduler.h"
+#include "oled_render.h"
+#include "rgb_manager.h"
+#include "marquee.h"
+#include "sparkline.h"
+#include "task_scheduler.h"
+#include "macro_player.h"
+#include "text_format.h"
 
 #define KEYMAP_UK
 
@@ -21,19 +32,30 @@
 #define NUM_SCREEN_LINES 8
 #define SCREEN_CHAR_WIDTH 20
 
-// Globals for Raw HID communication
-char received_data[HID_BUFFER_SIZE] = "--";
-char received_pc_stats[HID_BUFFER_SIZE] = "--";
-char received_network_stats[HID_BUFFER_SIZE] = "--";
-char received_song_info[HID_BUFFER_SIZE] = "--";
-char received_timer_info[HID_BUFFER_SIZE] = "--";
+// reported to the host in the HELLO handshake
+#define FIRMWARE_VARIANT "arrows"
 
-static uint32_t pc_status_timer = 0;
-static uint32_t blink_timer = 0;
-static uint32_t conditional_timer_poll = 0; // for timer completion polling on other layers (when timer active)
+// Latest provider data decoded from the host
+provider_state_t provider_state;
+
+// song text longer than the screen scrolls on the media layer
+marquee_t song_title_marquee;
+marquee_t song_artist_marquee;
+
+// recent PC stats, one sample per stats update from the host
+sparkline_t ram_history;
+sparkline_t cpu_history;
+
+#define HOST_POLL_MS 2000
+#define TIMER_BLINK_MS 2000
+#define TIMER_POLL_MS 30000
+
+static task_token_t blink_task = TASK_TOKEN_NONE;
+static task_token_t timer_poll_task = TASK_TOKEN_NONE; // for timer completion polling on other layers (when timer active)
 
 static bool blink_state = false;
 bool received_first_communication = false; // only build queue after we connect
+bool event_mode = false; // host pushes updates instead of answering each request
 
 enum layer_names {
     _BASE,
@@ -87,34 +109,119 @@ enum tap_dance_codes {
 };
 
 // -------------------------------------------------------------------------- //
-// Raw HID Declarations
+// Layer Descriptors
 // -------------------------------------------------------------------------- //
 
-enum PC_req_types {
-    PC_PERFORMANCE = 1,
-    NETWORK_TEST = 2,
-    CURRENT_SONG = 3,
-    REQUEST_RETEST = 4,
-    RGB_SEND = 5,
-    TIMER_STATUS = 6,
-    TIMER_PAUSE_REQ = 7,
-    TIMER_RESTART_REQ = 8,
-    TIMER_RESET_REQ = 9,
+// what a layer shows below its hints
+enum layer_widgets {
+    WIDGET_PC_STATUS,
+    WIDGET_NETWORK,
+    WIDGET_SONG,
+    WIDGET_TIMER,
+    WIDGET_IMAGE,
 };
 
-#define MAX_QUEUE_SIZE 100
-
+// Everything about a layer apart from its keys, read by the OLED, RGB and
+// polling code. A new layer needs an entry here and a LAYOUT in keymaps[].
 typedef struct {
-    int data[MAX_QUEUE_SIZE];
-    int size;
-} queue_t;
+    char title[SCREEN_CHAR_WIDTH + 1];
+    char hints[3][SCREEN_CHAR_WIDTH + 1]; // empty hints are left out
+    hsv_t colour;                         // also sent to the keyboard
+    uint8_t widget;
+    uint8_t kind;                         // reported in the HELLO handshake
+    uint8_t providers;                    // provider_flags the widget shows
+    uint8_t poll_request;                 // asked for every 2 s while polling, 0 for none
+} layer_desc_t;
+
+const layer_desc_t PROGMEM layer_descs[] = {
+    [_BASE] = {
+        .title = "Home Layer",
+        .hints = {"< lock computer", "v open vscode", "> email"},
+        .colour = {HSV_RED},
+        .widget = WIDGET_PC_STATUS,
+        .kind = LAYER_KIND_HOME,
+        .providers = PROVIDER_PC,
+        .poll_request = PC_PERFORMANCE,
+    },
+    [_PROGRAMING] = {
+        .title = "Programming Layer",
+        .hints = {"< comment separator", "v doxygen comment", "> todo comment"},
+        .colour = {HSV_BLUE},
+        .widget = WIDGET_PC_STATUS,
+        .kind = LAYER_KIND_PROGRAMMING,
+        .providers = PROVIDER_PC,
+        .poll_request = PC_PERFORMANCE,
+    },
+    [_GIT] = {
+        .title = "Git Layer",
+        .hints = {"< commit all", "v commit tracked", "> git status"},
+        .colour = {HSV_WHITE},
+        .widget = WIDGET_PC_STATUS,
+        .kind = LAYER_KIND_GIT,
+        .providers = PROVIDER_PC,
+        .poll_request = PC_PERFORMANCE,
+    },
+    [_MARKDOWN] = {
+        .title = "Markdown Layer",
+        .hints = {"< code block", "v latex block", "> latex inline"},
+        .colour = {HSV_PURPLE},
+        .widget = WIDGET_PC_STATUS,
+        .kind = LAYER_KIND_MARKDOWN,
+        .providers = PROVIDER_PC,
+        .poll_request = PC_PERFORMANCE,
+    },
+    [_NETWORK] = {
+        .title = "Internet Speed",
+        .hints = {"'v' to retest"},
+        .colour = {HSV_YELLOW},
+        .widget = WIDGET_NETWORK,
+        .kind = LAYER_KIND_NETWORK,
+        .providers = PROVIDER_NETWORK,
+        .poll_request = NETWORK_TEST,
+    },
+    [_MEDIA] = {
+        .title = "Media Player",
+        .colour = {HSV_GREEN},
+        .widget = WIDGET_SONG,
+        .kind = LAYER_KIND_MEDIA,
+        .providers = PROVIDER_SONG,
+        .poll_request = CURRENT_SONG,
+    },
+    [_POMODORO] = {
+        .title = "Pomodoro Timer",
+        .hints = {"< reset | v pause", "> start/restart"},
+        .colour = {HSV_ORANGE},
+        .widget = WIDGET_TIMER,
+        .kind = LAYER_KIND_POMODORO,
+        .providers = PROVIDER_TIMER,
+        .poll_request = TIMER_STATUS,
+    },
+    [_ARROWS] = {
+        .title = "Arrow Layer",
+        .colour = {HSV_CYAN},
+        .widget = WIDGET_IMAGE,
+        .kind = LAYER_KIND_ARROWS,
+        .providers = 0,
+        .poll_request = 0,
+    },
+};
+
+#define NUM_LAYERS (sizeof(layer_descs) / sizeof(layer_descs[0]))
+
+hsv_t layer_colour(int layer) {
+    hsv_t colour;
+    memcpy_P(&colour, &layer_descs[layer].colour, sizeof(colour));
+    return colour;
+}
+
+// -------------------------------------------------------------------------- //
+// Raw HID Declarations
+// -------------------------------------------------------------------------- //
 
 // Function declarations
-void initQueue(queue_t *q);
-int isFull(queue_t *q);
-int isEmpty(queue_t *q);
-int enqueue(queue_t *q, int value);
-int dequeue(queue_t *q, int *value);
+void send_request(uint8_t request);
+void send_subscription(void);
+void send_hello(void);
 void cycleLayers(bool forward);
 void handleOpenVscode(keyrecord_t *record);
 void handleGitCommit(keyrecord_t *record, bool commitTrackedOnly);
@@ -122,59 +229,94 @@ void handleCommandRun(keyrecord_t *record, char *command_str);
 void handleCommentSep(keyrecord_t *record);
 void handleDoxygenComment(keyrecord_t *record);
 void handleArrowToggle(keyrecord_t *record);
-void copy_buffer(uint8_t *src_buf, char *dest_buf);
-void categorise_received_data(void);
+void handle_timer_update(void);
+void apply_layer_colour(void);
+void draw_arrows_image(void);
+void draw_pc_history(uint8_t line);
 void write_pc_status_oled(void);
 void write_network_oled(void);
 void write_song_info_oled(void);
 void write_timer_info_oled(void);
 
+req_scheduler_t req_scheduler;
+
 // -------------------------------------------------------------------------- //
-// LIFO queue
+// Helper Functions
 // -------------------------------------------------------------------------- //
 
-void initQueue(queue_t *q) {
-    q->size = 0;
-}
+void send_rgb_to_keyboard(int data_to_send) {
 
-int isFull(queue_t *q) {
-    return q->size == MAX_QUEUE_SIZE;
+    if (received_first_communication) {
+        uint8_t rgb_send_buffer[HID_BUFFER_SIZE - 1];
+
+        // either layer number or the blinking colour, stamped for latency tracing
+        hsv_t colour = layer_colour(data_to_send);
+        hid_protocol_write_rgb(rgb_send_buffer, data_to_send, colour.h, colour.s, colour.v);
+
+        raw_hid_send(rgb_send_buffer, HID_BUFFER_SIZE - 1);
+    }
 }
 
-int isEmpty(queue_t *q) {
-    return q->size == 0;
+// providers shown on a layer, the host pushes these in event mode
+uint8_t layer_providers(int layer) {
+    return pgm_read_byte(&layer_descs[layer].providers);
 }
 
-int enqueue(queue_t *q, int value) {
-    if (isFull(q)) return 0;
-    q->data[q->size++] = value;
-    return 1;
+// In event mode requests go out immediately, otherwise they wait for the
+// next host report to be answered
+void send_request(uint8_t request) {
+    if (!event_mode) {
+        req_scheduler_push(&req_scheduler, request);
+        return;
+    }
+
+    uint8_t buffer[HID_BUFFER_SIZE - 1];
+    memset(buffer, 0, HID_BUFFER_SIZE - 1);
+    buffer[0] = request;
+    raw_hid_send(buffer, HID_BUFFER_SIZE - 1);
 }
 
-// Pop from the stack (LIFO)
-int dequeue(queue_t *q, int *value) {
-    if (isEmpty(q)) return 0;
-    *value = q->data[--q->size];
-    return 1;
+// Outside event mode the host only sends data it is asked for, so the
+// current layer's data is requested every HOST_POLL_MS
+uint32_t poll_host(uint32_t trigger_time, void *arg) {
+    if (!event_mode && received_first_communication) {
+        uint8_t request = pgm_read_byte(&layer_descs[curr_layer].poll_request);
+        if (request) {
+            req_scheduler_push(&req_scheduler, request);
+        }
+    }
+    return HOST_POLL_MS;
 }
 
-queue_t req_queue;
+void send_hello(void) {
+    uint8_t layer_kinds[NUM_LAYERS];
+
+    hid_hello_t hello = {
+        .screen_lines = NUM_SCREEN_LINES,
+        .screen_columns = SCREEN_CHAR_WIDTH,
+        .providers = 0,
+        .layer_count = NUM_LAYERS,
+        .layer_kinds = layer_kinds,
+        .variant = FIRMWARE_VARIANT,
+    };
+    for (int layer = 0; layer < (int)NUM_LAYERS; layer++) {
+        layer_kinds[layer] = pgm_read_byte(&layer_descs[layer].kind);
+        hello.providers |= layer_providers(layer);
+    }
 
-// -------------------------------------------------------------------------- //
-// Helper Functions
-// -------------------------------------------------------------------------- //
+    uint8_t buffer[HID_REPORT_SIZE];
+    hid_protocol_write_hello(buffer, &hello);
+    raw_hid_send(buffer, HID_REPORT_SIZE);
+}
 
-void send_rgb_to_keyboard(int data_to_send) {
+void send_subscription(void) {
+    if (!event_mode) return;
 
-    if (received_first_communication) {
-        uint8_t rgb_send_buffer[HID_BUFFER_SIZE - 1];
-        memset(rgb_send_buffer, 0, HID_BUFFER_SIZE - 1);
-    
-        rgb_send_buffer[0] = RGB_SEND;
-        rgb_send_buffer[1] = data_to_send; // either layer number or the blinking colour
-    
-        raw_hid_send(rgb_send_buffer, HID_BUFFER_SIZE - 1);
-    }
+    uint8_t buffer[HID_BUFFER_SIZE - 1];
+    memset(buffer, 0, HID_BUFFER_SIZE - 1);
+    buffer[0] = SUBSCRIBE;
+    buffer[1] = layer_providers(curr_layer);
+    raw_hid_send(buffer, HID_BUFFER_SIZE - 1);
 }
 
 int random_int_range(int min, int max){
@@ -195,6 +337,7 @@ void cycleLayers(bool forward) {
 
     // send rgb to python client to forward to keyboard
     send_rgb_to_keyboard(curr_layer);
+    send_subscription();
 }
 
 
@@ -208,48 +351,66 @@ void layerCycleTapDance(tap_dance_state_t *state, void *user_data) {
 
 void handleOpenVscode(keyrecord_t *record) {
     if (record->event.pressed) {
-        tap_code16(LGUI(KC_R));
-        wait_ms(100);
-        send_string("code");
-        tap_code(KC_ENTER);
+        static const macro_step_t open_vscode[] = {
+            MACRO_TAP(LGUI(KC_R)),
+            MACRO_DELAY(100),
+            MACRO_STRING("code"),
+            MACRO_TAP(KC_ENTER),
+        };
+        macro_player_play(open_vscode);
     }
 }
 
 void handleGitCommit(keyrecord_t *record, bool commitTrackedOnly) {
     if (record->event.pressed) {
-        tap_code16(LCTL(KC_GRAVE));
-        wait_ms(100);
+        static const macro_step_t commit_tracked[] = {
+            MACRO_TAP(LCTL(KC_GRAVE)),
+            MACRO_DELAY(100),
+            MACRO_STRING("git commit -am '' "),
+            MACRO_TAP(KC_NUHS), // UK # key
+            MACRO_STRING(" COMMIT TRACKED ONLY"),
+            MACRO_DELAY(100),
+            MACRO_TAP_N(KC_LEFT, 23),
+        };
+        static const macro_step_t commit_all[] = {
+            MACRO_TAP(LCTL(KC_GRAVE)),
+            MACRO_DELAY(100),
+            MACRO_STRING("git add . && git commit -m ''          "),
+            MACRO_TAP(KC_NUHS),
+            MACRO_STRING(" COMMIT ALL"),
+            MACRO_DELAY(100),
+            MACRO_TAP_N(KC_LEFT, 23),
+        };
+
         if (commitTrackedOnly) {
-            send_string("git commit -am '' ");
-            tap_code(KC_NUHS); // UK # key
-            send_string(" COMMIT TRACKED ONLY");
+            macro_player_play(commit_tracked);
         } else {
-            send_string("git add . && git commit -m ''          ");
-            tap_code(KC_NUHS);
-            send_string(" COMMIT ALL");
-        }
-        wait_ms(100);
-        for (int i = 0; i < 23; i++) {
-            tap_code(KC_LEFT);
+            macro_player_play(commit_all);
         }
     }
 }
 
 void handleCommandRun(keyrecord_t *record, char *command_str) {
     if (record->event.pressed) {
-        tap_code16(LCTL(KC_GRAVE));
-        wait_ms(100);
-        send_string(command_str);
-        tap_code(KC_ENTER);
+        const macro_step_t run_command[] = {
+            MACRO_TAP(LCTL(KC_GRAVE)),
+            MACRO_DELAY(100),
+            MACRO_STRING(command_str),
+            MACRO_TAP(KC_ENTER),
+        };
+        macro_player_play(run_command);
     }
 }
 
 void handleDateTodoComment(keyrecord_t *record) {
     if (record -> event.pressed) {
-        send_string("// TODO (");
-        tap_code16(KC_F12); // autohotkey bound to date
-        wait_ms(200);
-        send_string("): ");
+        static const macro_step_t todo_comment[] = {
+            MACRO_STRING("// TODO ("),
+            MACRO_TAP(KC_F12), // autohotkey bound to date
+            MACRO_DELAY(200),
+            MACRO_STRING("): "),
+        };
+        macro_player_play(todo_comment);
     }
 }
 
@@ -288,8 +449,8 @@ void handleArrowToggle(keyrecord_t *record) {
 
     if (record -> event.pressed) {
         
-        // display random image
-        chosen_image = random_int_range(0, NUM_IMAGES - 1);
+        // display random image, built in or uploaded
+        chosen_image = random_int_range(0, NUM_IMAGES + image_slots_available() - 1);
 
         if (curr_layer != _ARROWS) {
             return_layer = curr_layer;
@@ -298,6 +459,7 @@ void handleArrowToggle(keyrecord_t *record) {
             curr_layer = return_layer;
         }
         layer_move(curr_layer);
+        send_subscription();
     }
 }
 
@@ -346,135 +508,159 @@ void handleLatexInline(keyrecord_t *record) {
 }
 
 
-void copy_buffer(uint8_t *src_buf, char *dest_buf) {
-    memcpy(dest_buf, (char*)src_buf, HID_BUFFER_SIZE - 1);
-    dest_buf[HID_BUFFER_SIZE - 1] = '\0';
+// Alternates white and green until the finished timer is dismissed
+uint32_t blink_timer_completed(uint32_t trigger_time, void *arg) {
+    if (!timer_completed) {
+        blink_task = TASK_TOKEN_NONE;
+        return 0;
+    }
+
+    blink_state = !blink_state;
+    if (blink_state) {
+        rgb_manager_set(layer_colour(WHITE));
+        send_rgb_to_keyboard(WHITE);
+    } else {
+        rgb_manager_set(layer_colour(GREEN));
+        send_rgb_to_keyboard(GREEN);
+    }
+    return TIMER_BLINK_MS;
 }
 
-void categorise_received_data(void) {
-    int data_id = received_data[0] - '0';
+// The timer's layer polls it anyway, this catches it finishing on the others
+uint32_t poll_timer_status(uint32_t trigger_time, void *arg) {
+    if (!timer_active) {
+        timer_poll_task = TASK_TOKEN_NONE;
+        return 0;
+    }
 
-    switch (data_id) {
-        case PC_PERFORMANCE:
-            copy_buffer((uint8_t*)(received_data + 1), received_pc_stats);
-            break;
-        case NETWORK_TEST:
-            copy_buffer((uint8_t*)(received_data + 1), received_network_stats);
-            break;
-        case CURRENT_SONG:
-            copy_buffer((uint8_t*)(received_data + 1), received_song_info);
-            break;
-        case TIMER_STATUS:
-            copy_buffer((uint8_t*)(received_data + 1), received_timer_info);
-            // Check if timer completed
-            if (strstr(received_timer_info, "COMPLETED") != NULL) {
-                timer_completed = true;
-                timer_active = false;
-                blink_timer = timer_read32();
-            } else {
-                timer_completed = false;
-            }
-            break;
+    if (!event_mode) {
+        req_scheduler_push(&req_scheduler, TIMER_STATUS);
     }
+    return TIMER_POLL_MS;
 }
 
-void write_pc_status_oled(void) {
-    static char pc_status_str[100] = "RAM:-- CPU:-- B:--";
+void handle_timer_update(void) {
+    if (provider_state.timer.state == TIMER_STATE_COMPLETED) {
+        timer_completed = true;
+        timer_active = false;
+        if (blink_task == TASK_TOKEN_NONE) {
+            blink_task = task_schedule(TIMER_BLINK_MS, blink_timer_completed, NULL);
+        }
+    } else {
+        timer_completed = false;
+    }
+}
+
+// runs every housekeeping pass, the RGB manager ignores an unchanged colour
+void apply_layer_colour(void) {
+    if (timer_completed) return;
+
+    rgb_manager_fade_to(layer_colour(curr_layer));
+}
 
-    char ram_buf[16] = "--";
-    char cpu_buf[16] = "--";
-    char bat_buf[16] = "--";
+void draw_arrows_image(void) {
+    if (chosen_image < NUM_IMAGES) {
+        bitmap_rle_draw(pgm_read_ptr(&bitmaps_arr[chosen_image]), BITMAP_SIZE);
+    } else {
+        image_slots_draw(chosen_image - NUM_IMAGES);
+    }
+}
 
-    // Parse the new data
-    sscanf(received_pc_stats, "%15[^|]|%15[^|]|%15s", ram_buf, cpu_buf, bat_buf);
+// RAM history on the left and CPU on the right, under their numbers
+void draw_pc_history(uint8_t line) {
+    sparkline_draw(&ram_history, line, 0);
+    for (uint8_t x = SPARKLINE_WIDTH; x < OLED_DISPLAY_WIDTH - SPARKLINE_WIDTH; x++) {
+        oled_write_raw_byte(0, line * OLED_DISPLAY_WIDTH + x);
+    }
+    sparkline_draw(&cpu_history, line, OLED_DISPLAY_WIDTH - SPARKLINE_WIDTH);
+}
 
-    snprintf(pc_status_str, sizeof(pc_status_str), "RAM:%s CPU:%s B:%s", ram_buf, cpu_buf, bat_buf);
+void write_pc_status_oled(void) {
+    static char pc_status_str[32] = "RAM:-- CPU:-- B:--";
+
+    if (provider_state.pc.valid) {
+        char *p = format_str(pc_status_str, "RAM:");
+        p = format_uint(p, provider_state.pc.ram, 2);
+        p = format_str(p, " CPU:");
+        p = format_uint(p, provider_state.pc.cpu, 2);
+        p = format_str(p, " B:");
+        format_uint(p, provider_state.pc.battery, 2);
+    }
 
-    oled_write_ln(pc_status_str, false);
-    oled_write_ln("", false);
+    render_ln(pc_status_str);
+    render_line_raw(draw_pc_history);
 }
 
 void write_network_oled(void) {
-    static char network_display[200] = "No test data";
-    
-    // Check if we have received network data
-    if (strcmp(received_network_stats, "--") != 0) {
-        char download[16] = "--";
-        char upload[16] = "--";
-        
-        // Parse the received data
-        sscanf(received_network_stats, "%15[^|]|%15s", download, upload);
-        
-        // Check if it's a test in progress
-        if (strstr(download, "testing") != NULL) {
-            snprintf(network_display, sizeof(network_display), 
-                     "Testing... %s", upload);
-        } else if (strcmp(download, "--") != 0 && strcmp(upload, "--") != 0) {
-            // We have actual results
-            snprintf(network_display, sizeof(network_display), 
-                     "Download: %s Mbps\nUpload: %s Mbps", download, upload);
-        } else {
-            strcpy(network_display, "No data available");
-        }
+    static char network_display[32] = "No test data";
+    static char network_upload[32] = "";
+    network_stats_t *net = &provider_state.network;
+
+    if (net->state == NETWORK_TESTING) {
+        char *p = format_str(network_display, "Testing... ");
+        p = format_uint(p, net->elapsed_s, 1);
+        format_str(p, "s");
+        network_upload[0] = '\0';
+    } else if (net->state == NETWORK_COMPLETED) {
+        char *p = format_str(network_display, "Download: ");
+        p = format_fixed_x10(p, net->download_x10);
+        format_str(p, " Mbps");
+        p = format_str(network_upload, "Upload: ");
+        p = format_fixed_x10(p, net->upload_x10);
+        format_str(p, " Mbps");
+    } else if (net->state == NETWORK_IDLE) {
+        format_str(network_display, "No data available");
+        network_upload[0] = '\0';
     }
-    
-    oled_write_ln(network_display, false);
-    oled_write_ln("", false);
+
+    render_ln(network_display);
+    render_ln(network_upload);
 }
 
 void write_song_info_oled(void) {
-    // First, check if the data from the host is the default "no data" message.
-    if (strcmp(received_song_info, "--") == 0 || strcmp(received_song_info, "--|--") == 0) {
-        oled_write_ln("No song playing", false);
-        oled_write_ln("", false);
+    if (!provider_state.song.valid) {
+        render_ln("No song playing");
+        render_ln("");
         return;
     }
 
-    char song_name[32] = "";
-    char artist_name[32] = "";
-
-    // Parse the "song|artist" string received from client.
-    sscanf(received_song_info, "%31[^|]|%31[^\n]", song_name, artist_name);
-
-    // Check if parsing was successful and gave us a valid song title.
-    if (strlen(song_name) > 0) {
-
-        oled_write_ln(song_name, false);
-        oled_write_ln(artist_name, false);
+    char line[RENDER_COLUMNS + 1];
 
-    } else {
-        oled_write_ln("No song playing", false);
-        oled_write_ln("", false);
-    }
+    marquee_window(&song_title_marquee, line);
+    render_ln(line);
+    marquee_window(&song_artist_marquee, line);
+    render_ln(line);
 }
 
 void write_timer_info_oled(void) {
     // Check if we have received timer data
-    if (strcmp(received_timer_info, "--") == 0) {
-        oled_write_ln("Timer not started", false);
-        oled_write_ln("", false);
+    if (!provider_state.timer.valid) {
+        render_ln("Timer not started");
+        render_ln("");
         return;
     }
 
-    char status[16] = "";
-    char time_remaining[16] = "";
-
-    // Parse the "status|time" string received from client
-    sscanf(received_timer_info, "%15[^|]|%15s", status, time_remaining);
+    char time_remaining[16];
+    format_hhmmss(time_remaining, provider_state.timer.remaining_s);
 
-    if (strcmp(status, "COMPLETED") == 0) {
-        oled_write_ln("TIMER FINISHED!", false);
-    } else if (strcmp(status, "PAUSED") == 0) {
-        oled_write_ln("Timer PAUSED", false);
-        oled_write_ln(time_remaining, false);
-    } else if (strcmp(status, "RUNNING") == 0) {
-        oled_write_ln(time_remaining, false);
-    } else {
-        // handles the "STOPPED" state and any other initial states
-        oled_write_ln("Timer Ready", false);
+    switch (provider_state.timer.state) {
+        case TIMER_STATE_COMPLETED:
+            render_ln("TIMER FINISHED!");
+            break;
+        case TIMER_STATE_PAUSED:
+            render_ln("Timer PAUSED");
+            render_ln(time_remaining);
+            break;
+        case TIMER_STATE_RUNNING:
+            render_ln(time_remaining);
+            break;
+        default:
+            // handles the "STOPPED" state and any other initial states
+            render_ln("Timer Ready");
+            break;
     }
 
-    oled_write_ln("", false);
+    render_ln("");
 }
 
 
@@ -495,67 +681,106 @@ bool encoder_update_user(uint8_t index, bool clockwise) {
 
 
 void keyboard_post_init_user(void) {
-    initQueue(&req_queue);
+    req_scheduler_init(&req_scheduler);
+    image_slots_init();
 
     backlight_disable();
-    rgblight_enable();
-    rgblight_mode(RGBLIGHT_MODE_STATIC_LIGHT);
-    rgblight_sethsv(HSV_RED);
+    rgb_manager_init(layer_colour(_BASE));
+
+    // the display and RGB toggle is saved with the RGB on/off state
+    display_enabled = rgb_manager_enabled();
+
+    task_schedule(HOST_POLL_MS, poll_host, NULL);
 }
 
 void matrix_scan_user(void) {
-    // Handle timer completion blinking
-    if (timer_completed && timer_elapsed32(blink_timer) > 2000) {
-        blink_timer = timer_read32();
-        blink_state = !blink_state;
-        if (blink_state) {
-            rgblight_sethsv(HSV_WHITE);
-            send_rgb_to_keyboard(WHITE);
-        } else {
-            rgblight_sethsv(HSV_GREEN);
-            send_rgb_to_keyboard(GREEN);
-        }
-    }
-
-    // Check if 2 seconds have passed since the last request
-    if (timer_elapsed32(pc_status_timer) > 2000 && received_first_communication) {
-        // Reset the timer
-        pc_status_timer = timer_read32();
-        if (curr_layer <= _MARKDOWN) {
-            enqueue(&req_queue, PC_PERFORMANCE);
-        } else if (curr_layer == _NETWORK) {
-            enqueue(&req_queue, NETWORK_TEST);
-        } else if (curr_layer == _MEDIA) {
-            enqueue(&req_queue, CURRENT_SONG);
-        } else if (curr_layer == _POMODORO) {
-            enqueue(&req_queue, TIMER_STATUS);
+    render_count_scan();
+    rgb_manager_task();
+    image_slots_task();
+    task_scheduler_task();
+
+    // scrolling song text redraws only the line that moved
+    if (pgm_read_byte(&layer_descs[curr_layer].widget) == WIDGET_SONG) {
+        bool moved = marquee_task(&song_title_marquee);
+        moved |= marquee_task(&song_artist_marquee);
+        if (moved) {
+            render_mark_dirty();
         }
     }
-
-    if (timer_active && timer_elapsed32(conditional_timer_poll) > 30000) {
-        conditional_timer_poll = timer_read32();
-        enqueue(&req_queue, TIMER_STATUS);
-    }
 }
 
 void raw_hid_receive(uint8_t *data, uint8_t length) {
     // printf("Raw HID data received\n");
 
+    // image uploads and streamed frames have their own framing and never get
+    // a request back
+    if (image_slots_receive(data, length) || frame_stream_receive(data, length)) {
+        return;
+    }
+
     if (!received_first_communication) {
         received_first_communication = true;
     }
 
-    // save received data
-    copy_buffer(data, received_data);
+    bool was_event_mode = event_mode;
+    event_mode = hid_protocol_flags(data, length) & HID_FLAG_EVENT_MODE;
+
+    uint8_t updated = hid_protocol_decode(data, length, &provider_state);
+
+    if (updated & PROVIDER_TIMER) {
+        handle_timer_update();
+    }
+
+    // the host only sends the latest stats, history is kept here
+    if ((updated & PROVIDER_PC) && provider_state.pc.valid) {
+        sparkline_push(&ram_history, provider_state.pc.ram);
+        sparkline_push(&cpu_history, provider_state.pc.cpu);
+    }
+
+    if (updated & PROVIDER_SONG) {
+        marquee_set(&song_title_marquee, provider_state.song.title);
+        marquee_set(&song_artist_marquee, provider_state.song.artist);
+    }
+
+    if (updated & layer_providers(curr_layer)) {
+        render_mark_dirty();
+    }
+
+    if (updated & KEYFRAME_NEEDED) {
+        send_request(KEYFRAME_REQ);
+    }
+
+    // only answer once the whole message is in
+    if (updated & MESSAGE_INCOMPLETE) {
+        return;
+    }
+
+    // the hello answer replaces the usual reply in either mode
+    if (updated & HOST_HELLO) {
+        send_hello();
+        return;
+    }
 
-    categorise_received_data();
+    if (event_mode) {
+        // flush anything queued while the host was still polling
+        if (!was_event_mode) {
+            uint8_t queued;
+            while (req_scheduler_pop(&req_scheduler, &queued)) {
+                send_request(queued);
+            }
+        }
+        if (updated & HOST_SYNC_REQUEST) {
+            send_subscription();
+        }
+        return;
+    }
 
     // responding to client with next request
     uint8_t response[length];
     memset(response, 0, length);
 
-    int req_enum;
-    dequeue(&req_queue, &req_enum);
+    uint8_t req_enum = 0;
+    req_scheduler_pop(&req_scheduler, &req_enum);
 
     response[0] = req_enum;
 
@@ -573,86 +798,60 @@ bool oled_task_user(void) {
         return false;
     }
 
+    apply_layer_colour();
+
+    // the host is drawing the whole screen
+    if (frame_stream_active()) {
+        return false;
+    }
+
     static int last_layer = -1;
     
     if (last_layer != curr_layer) {
-        oled_clear();
+        render_invalidate();
         last_layer = curr_layer;
     }
 
-    switch (curr_layer) {
-        case _BASE:
-            if (!timer_completed) rgblight_sethsv(HSV_RED);
-            oled_write_ln("Home Layer", false);
-            oled_write_ln("", false);
-            oled_write_ln("< lock computer", false);
-            oled_write_ln("v open vscode", false);
-            oled_write_ln("> email", false);
-            oled_write_ln("", false);
-            write_pc_status_oled();
-            break;
-        case _PROGRAMING:
-            if (!timer_completed) rgblight_sethsv(HSV_BLUE);
-            oled_write_ln("Programming Layer", false);
-            oled_write_ln("", false);
-            oled_write_ln("< comment separator", false);
-            oled_write_ln("v doxygen comment", false);
-            oled_write_ln("> todo comment", false);
-            oled_write_ln("", false);
-            write_pc_status_oled();
-            break;
-        case _GIT:
-            if (!timer_completed) rgblight_sethsv(HSV_WHITE);
-            oled_write_ln("Git Layer", false);
-            oled_write_ln("", false);
-            oled_write_ln("< commit all", false);
-            oled_write_ln("v commit tracked", false);
-            oled_write_ln("> git status", false);
-            oled_write_ln("", false);
-            write_pc_status_oled();
-            break;
-        case _MARKDOWN:
-            if (!timer_completed) rgblight_sethsv(HSV_PURPLE);
-            oled_write_ln("Markdown Layer", false);
-            oled_write_ln("", false);
-            oled_write_ln("< code block", false);
-            oled_write_ln("v latex block", false);
-            oled_write_ln("> latex inline", false);
-            oled_write_ln("", false);
+    // nothing on screen changed, skip formatting and OLED writes
+    if (!render_begin_frame()) {
+        return false;
+    }
+
+    layer_desc_t layer;
+    memcpy_P(&layer, &layer_descs[curr_layer], sizeof(layer));
+
+    // cover art from the host takes the place of the title and hints
+    if (layer.widget == WIDGET_SONG && image_slots_album_art()) {
+        render_raw(BITMAP_SIZE / OLED_DISPLAY_WIDTH, image_slots_draw_album_art);
+    } else {
+        render_ln(layer.title);
+        render_ln("");
+        for (int i = 0; i < 3; i++) {
+            if (layer.hints[i][0]) render_ln(layer.hints[i]);
+        }
+        render_ln("");
+    }
+
+    switch (layer.widget) {
+        case WIDGET_PC_STATUS:
             write_pc_status_oled();
             break;
-        case _NETWORK:
-            if (!timer_completed) rgblight_sethsv(HSV_YELLOW);
-            oled_write_ln("Internet Speed", false);
-            oled_write_ln("", false);
-            oled_write_ln("'v' to retest", false);
-            oled_write_ln("", false);
+        case WIDGET_NETWORK:
             write_network_oled();
             break;
-        case _MEDIA:
-            if (!timer_completed) rgblight_sethsv(HSV_GREEN);
-            oled_write_ln("Media Player", false);
-            oled_write_ln("", false);
-            oled_write_ln("", false);
+        case WIDGET_SONG:
             write_song_info_oled();
             break;
-        case _POMODORO:
-            if (!timer_completed) rgblight_sethsv(HSV_ORANGE);
-            oled_write_ln("Pomodoro Timer", false);
-            oled_write_ln("", false);
-            oled_write_ln("< reset | v pause", false);
-            oled_write_ln("> start/restart", false);
-            oled_write_ln("", false);
+        case WIDGET_TIMER:
             write_timer_info_oled();
             break;
-        case _ARROWS:
-            if (!timer_completed) rgblight_sethsv(HSV_CYAN);
-            oled_write_ln("Arrow Layer", false);
-            oled_write_ln("", false);
-            oled_write_raw_P((const char *)bitmaps_arr[chosen_image], BITMAP_SIZE);
+        case WIDGET_IMAGE:
+            render_raw(BITMAP_SIZE / OLED_DISPLAY_WIDTH, draw_arrows_image);
             break;
     }
 
+    render_end_frame();
+
     return false;
 }
 
@@ -728,28 +927,31 @@ bool process_record_user(uint16_t keycode, keyrecord_t *record) {
         // Network layer macro
         case REQUEST_RETEST_KEY: {
             if (record->event.pressed) {
-                enqueue(&req_queue, REQUEST_RETEST);
+                send_request(REQUEST_RETEST);
             }
             return false;
         }
         // Timer macros
         case TIMER_PAUSE: {
             if (record->event.pressed) {
-                enqueue(&req_queue, TIMER_PAUSE_REQ);
+                send_request(TIMER_PAUSE_REQ);
             }
             return false;
         }
         case TIMER_RESTART: {
             if (record->event.pressed) {
-                enqueue(&req_queue, TIMER_RESTART_REQ);
+                send_request(TIMER_RESTART_REQ);
                 timer_completed = false;
                 timer_active = true;
+                if (timer_poll_task == TASK_TOKEN_NONE) {
+                    timer_poll_task = task_schedule(TIMER_POLL_MS, poll_timer_status, NULL);
+                }
             }
             return false;
         }
         case TIMER_RESET: {
             if (record->event.pressed) {
-                enqueue(&req_queue, TIMER_RESET_REQ);
+                send_request(TIMER_RESET_REQ);
                 timer_completed = false;
                 timer_active = false;
             }
@@ -758,11 +960,7 @@ bool process_record_user(uint16_t keycode, keyrecord_t *record) {
         case DISPLAY_TOGGLE: {
             if (record->event.pressed) {
                 display_enabled = !display_enabled;
-                if (display_enabled) {
-                    rgblight_enable();
-                } else {
-                    rgblight_disable();
-                }
+                rgb_manager_set_enabled(display_enabled);
             }
             return false;
         }
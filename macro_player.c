@@ -0,0 +1,69 @@
+#include "macro_player.h"
+#include "task_scheduler.h"
+
+static macro_step_t queue[MACRO_QUEUE_SIZE];
+static uint8_t head = 0;
+static uint8_t count = 0;
+
+// taps or characters of the step at head already sent
+static uint8_t progress = 0;
+
+static task_token_t player = TASK_TOKEN_NONE;
+
+// Plays the next key of the step at head, returns the wait until the one after
+static uint32_t play(uint32_t trigger_time, void *arg) {
+    macro_step_t *step = &queue[head];
+    uint32_t delay = MACRO_KEY_MS;
+    bool done = true;
+
+    switch (step->kind) {
+        case MACRO_STEP_TAP:
+            if (progress < step->times) {
+                tap_code16(step->value);
+                progress++;
+            }
+            done = progress >= step->times;
+            break;
+        case MACRO_STEP_STRING:
+            if (step->text[progress] != '\0') {
+                send_char(step->text[progress++]);
+            }
+            done = step->text[progress] == '\0';
+            break;
+        case MACRO_STEP_DELAY:
+            delay = step->value;
+            break;
+    }
+
+    if (done) {
+        head = (head + 1) % MACRO_QUEUE_SIZE;
+        count--;
+        progress = 0;
+    }
+
+    if (count == 0) {
+        player = TASK_TOKEN_NONE;
+        return 0;
+    }
+    return delay;
+}
+
+bool macro_player_queue(const macro_step_t *steps, uint8_t length) {
+    // all or nothing, half a macro typed into a terminal is worse than none
+    if (length > MACRO_QUEUE_SIZE - count) return false;
+
+    for (uint8_t i = 0; i < length; i++) {
+        queue[(head + count + i) % MACRO_QUEUE_SIZE] = steps[i];
+    }
+    count += length;
+
+    // the first key goes out on the next scan
+    if (count && player == TASK_TOKEN_NONE) {
+        player = task_schedule(0, play, NULL);
+    }
+    return true;
+}
+
+bool macro_player_busy(void) {
+    return count > 0;
+}
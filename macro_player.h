@@ -0,0 +1,54 @@
+#pragma once
+
+#include "quantum.h"
+
+// Plays macros from the scan loop instead of blocking it. A macro is a list
+// of taps, strings and delays, and one key goes out per MACRO_KEY_MS from a
+// task_scheduler.h task, so delays never hold up the matrix scan, the OLED
+// or raw HID. Keys pressed while a macro plays work as normal and their
+// output lands between the macro's keys. Macros queued together play one
+// after the other, and a macro is only ever queued whole.
+
+// room for the longest keymap macro (7 steps) twice over
+#ifndef MACRO_QUEUE_SIZE
+#    define MACRO_QUEUE_SIZE 16
+#endif
+
+// gap between keys, one USB poll
+#ifndef MACRO_KEY_MS
+#    define MACRO_KEY_MS 1
+#endif
+
+enum macro_step_kinds {
+    MACRO_STEP_TAP,
+    MACRO_STEP_STRING,
+    MACRO_STEP_DELAY,
+};
+
+typedef struct {
+    uint8_t kind;
+    uint8_t times;       // MACRO_STEP_TAP
+    uint16_t value;      // keycode or delay in ms
+    const char *text;    // MACRO_STEP_STRING
+} macro_step_t;
+
+// Taps keycode (with any modifiers) times times
+#define MACRO_TAP_N(keycode, n) {.kind = MACRO_STEP_TAP, .times = (n), .value = (keycode)}
+#define MACRO_TAP(keycode) MACRO_TAP_N(keycode, 1)
+
+// Types text a character at a time. The text is not copied, so it must
+// outlive the macro, string literals are fine.
+#define MACRO_STRING(str) {.kind = MACRO_STEP_STRING, .text = (str)}
+
+// Waits ms before the next step
+#define MACRO_DELAY(ms) {.kind = MACRO_STEP_DELAY, .value = (ms)}
+
+// Queues count steps behind anything already playing. Returns false, queuing
+// nothing, when they don't all fit.
+bool macro_player_queue(const macro_step_t *steps, uint8_t count);
+
+// Queues a whole array of steps
+#define macro_player_play(steps) macro_player_queue(steps, sizeof(steps) / sizeof(steps[0]))
+
+// True while steps are waiting to play
+bool macro_player_busy(void);
@@ -0,0 +1,173 @@
+"""
+Cover art for the media layer. The art of the playing track is downscaled
+to a 48x48 thumbnail, ordered dithered to 1bpp and centred in a 128x48
+image, which is sent to the macropad's IMAGE_SLOT_ALBUM_ART (see
+image_slots.h) whenever the track changes.
+
+Decoding and dithering run on AlbumArtWorker's own thread, so they never
+hold up the HID loop. Results are cached on disk by track id, so a track
+that comes round again costs one file read. Needs numpy and Pillow, without
+them there is simply no cover art.
+"""
+
+import io
+import os
+import re
+import threading
+import urllib.request
+
+import macropad_bitmaps as bitmaps
+
+try:
+    import numpy as np
+    from PIL import Image, ImageOps
+
+    AVAILABLE = True
+except ImportError:
+    AVAILABLE = False
+
+WIDTH = bitmaps.WIDTH
+HEIGHT = bitmaps.HEIGHT
+ART_SIZE = HEIGHT  # square thumbnail, the full height of the image
+FETCH_TIMEOUT = 10  # seconds
+
+# 8x8 Bayer matrix, thresholds spread evenly over 0..255
+BAYER_8 = [
+    [0, 32, 8, 40, 2, 34, 10, 42],
+    [48, 16, 56, 24, 50, 18, 58, 26],
+    [12, 44, 4, 36, 14, 46, 6, 38],
+    [60, 28, 52, 20, 62, 30, 54, 22],
+    [3, 35, 11, 43, 1, 33, 9, 41],
+    [51, 19, 59, 27, 49, 17, 57, 25],
+    [15, 47, 7, 39, 13, 45, 5, 37],
+    [63, 31, 55, 23, 61, 29, 53, 21],
+]
+
+if AVAILABLE:
+    THRESHOLDS = np.tile((np.array(BAYER_8) + 0.5) * 255 / 64, (HEIGHT // 8, WIDTH // 8))
+    PAGE_BITS = (1 << np.arange(8, dtype=np.uint16)).reshape(1, 8, 1)
+
+
+def dither(gray):
+    """HEIGHT x WIDTH grey levels to lit pixels, ordered dither in one comparison"""
+    return gray > THRESHOLDS
+
+
+def pack_pages(lit):
+    """HEIGHT x WIDTH lit pixels to OLED page bytes, the numpy pixels_to_pages()"""
+    pages = (lit.reshape(HEIGHT // 8, 8, WIDTH) * PAGE_BITS).sum(axis=1)
+    return pages.astype(np.uint8).tobytes()
+
+
+def render(data):
+    """OLED page bytes of encoded image data, such as a JPEG from Spotify"""
+    with Image.open(io.BytesIO(data)) as image:
+        # JPEGs decode straight at a fraction of their size, far cheaper
+        image.draft("L", (ART_SIZE * 2, ART_SIZE * 2))
+        thumbnail = ImageOps.fit(image.convert("L"), (ART_SIZE, ART_SIZE), Image.BOX)
+
+    gray = np.zeros((HEIGHT, WIDTH), dtype=np.uint8)
+    left = (WIDTH - ART_SIZE) // 2
+    gray[:, left : left + ART_SIZE] = np.asarray(ImageOps.autocontrast(thumbnail))
+    return pack_pages(dither(gray))
+
+
+def pick_image(images):
+    """URL of the smallest Spotify image that is still at least ART_SIZE high"""
+    usable = [i for i in images if (i.get("height") or 0) >= ART_SIZE] or images
+    if not usable:
+        return None
+    return min(usable, key=lambda i: i.get("height") or 0)["url"]
+
+
+class AlbumArtCache:
+    """Slot data (RLE compressed page bytes) on disk, one file per track id"""
+
+    def __init__(self, directory):
+        self.directory = directory
+
+    def path(self, track_id):
+        return os.path.join(self.directory, re.sub(r"\W", "_", track_id) + ".rle")
+
+    def get(self, track_id):
+        try:
+            with open(self.path(track_id), "rb") as f:
+                return f.read()
+        except OSError:
+            return None
+
+    def put(self, track_id, data):
+        os.makedirs(self.directory, exist_ok=True)
+        path = self.path(track_id)
+        with open(path + ".tmp", "wb") as f:
+            f.write(data)
+        os.replace(path + ".tmp", path)
+
+
+class AlbumArtWorker:
+    """
+    Turns track changes into slot data on a background thread. current is
+    (track id, slot data or None) for the newest track whose art is done,
+    every listener is called when it changes. A track that changes again
+    before its art is done is skipped.
+    """
+
+    def __init__(self, cache_dir, fetch=None):
+        self.cache = AlbumArtCache(cache_dir)
+        self.fetch = fetch or self._fetch
+        self.lock = threading.Lock()
+        self.wanted = threading.Event()
+        self.requested = None
+        self.pending = None
+        self.current = (None, None)
+        self.listeners = []
+        self.thread = None
+
+    def request(self, track_id, url):
+        """The playing track, None when nothing plays. Cheap, call it often."""
+        with self.lock:
+            if track_id == self.requested:
+                return
+            self.requested = track_id
+            self.pending = (track_id, url)
+            if self.thread is None:
+                self.thread = threading.Thread(target=self._run, daemon=True)
+                self.thread.start()
+        self.wanted.set()
+
+    def load(self, track_id, url):
+        """Slot data for a track, from the cache or made from its cover art"""
+        if track_id is None:
+            return None
+
+        data = self.cache.get(track_id)
+        if data is not None or not (AVAILABLE and url):
+            return data
+
+        data = bitmaps.encode_for_slot(render(self.fetch(url)))
+        self.cache.put(track_id, data)
+        return data
+
+    def _fetch(self, url):
+        with urllib.request.urlopen(url, timeout=FETCH_TIMEOUT) as response:
+            return response.read()
+
+    def _run(self):
+        while True:
+            self.wanted.wait()
+            self.wanted.clear()
+            with self.lock:
+                track_id, url = self.pending
+
+            try:
+                data = self.load(track_id, url)
+            except Exception:
+                data = None  # no art is better than a stuck worker
+
+            with self.lock:
+                if track_id != self.requested:
+                    continue  # the track changed while this one was loading
+                self.current = (track_id, data)
+
+            for listener in self.listeners:
+                listener()
@@ -0,0 +1,830 @@
+"""
+Benchmarks for the client, run against simulated devices so no hardware is
+needed.
+
+    python macropad_benchmark.py layers [--count N] [--interval MS] [--usb-interval MS] [--uhid]
+    python macropad_benchmark.py images [IMAGE ...] [--count N] [--usb-interval MS] [--eeprom-ms MS] [--uhid]
+    python macropad_benchmark.py stream [--frames N] [--usb-interval MS]
+    python macropad_benchmark.py art [IMAGE ...] [--count N]
+
+layers: end-to-end latency of a macropad layer change reaching the keyboard's
+RGB, through the real client code (HidReactor and KeyboardManager). Every
+hop timestamps the change by its RGB_SEND sequence number:
+
+    sent     macropad firmware sends RGB_SEND (cycleLayers -> send_rgb_to_keyboard)
+    read     the client's reactor dispatches it
+    written  KeyboardManager writes it to the keyboard
+    applied  keyboard firmware sets the colour (raw_hid_receive -> rgblight_sethsv)
+    receipt  the client receives the keyboard's RGB_RECEIPT echo
+
+By default both devices are simulated in process and model full-speed USB,
+where reports only move on the next poll of the interrupt endpoint. With
+--uhid they are virtual kernel devices created through /dev/uhid (Linux, root)
+and the client uses its hidraw backend, so the kernel path is measured too.
+
+images: upload time and throughput of arrows layer images sent to the
+macropad's EEPROM slots with macropad_bitmaps.upload(), against a model of
+image_slots.c that writes IMAGE_WRITE_CHUNK bytes per matrix scan, each write
+taking --eeprom-ms. Every upload is checked against the image afterwards.
+
+stream: frame rate and bytes per frame of macropad_stream.FrameEncoder for a
+few kinds of screen change, sent back to back to a model of frame_stream.c.
+Every frame shown is checked against the frame that was sent.
+
+art: cost of turning cover art into the media layer image with
+macropad_album_art, on local image files: decode and downscale, the numpy
+dither against a per pixel Python loop, a disk cache hit, and a track change
+through AlbumArtWorker until the art is ready to send. Needs numpy and Pillow.
+"""
+
+import argparse
+import glob
+import math
+import os
+import queue
+import random
+import sys
+import tempfile
+import threading
+import time
+
+_stdout, _stderr = sys.stdout, sys.stderr
+import macropad_client_hid as client
+
+# the client silences output for its .exe build
+sys.stdout, sys.stderr = _stdout, _stderr
+
+import macropad_album_art as album_art
+import macropad_bitmaps as bitmaps
+import macropad_hidraw as hidraw
+import macropad_protocol as proto
+import macropad_stream as stream
+
+# pid.codes test ids, so the virtual devices never match real hardware
+UHID_VENDOR_ID = 0x1209
+UHID_MACROPAD_PRODUCT_ID = 0x0001
+UHID_KEYBOARD_PRODUCT_ID = 0x0002
+
+NUM_LAYERS = 7
+
+HOPS = ("sent", "read", "written", "applied", "receipt")
+
+
+def now():
+    return time.perf_counter()
+
+
+def next_poll(interval):
+    """When the host next polls an interrupt endpoint with this interval"""
+    if interval <= 0:
+        return now()
+    return math.ceil(now() / interval) * interval
+
+
+def sleep_until(deadline):
+    delay = deadline - now()
+    if delay > 0:
+        time.sleep(delay)
+
+
+def percentile(sorted_values, fraction):
+    """Nearest-rank percentile"""
+    index = max(0, math.ceil(fraction * len(sorted_values)) - 1)
+    return sorted_values[index]
+
+
+class Trace:
+    """Timestamps of every hop, keyed by RGB_SEND sequence number"""
+
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.hops = {}
+        self.done = threading.Condition(self.lock)
+
+    def mark(self, seq, hop, at=None):
+        with self.lock:
+            self.hops.setdefault(seq, {})[hop] = now() if at is None else at
+            if hop == "receipt":
+                self.done.notify_all()
+
+    def wait_for(self, seq, timeout):
+        with self.done:
+            return self.done.wait_for(
+                lambda: "receipt" in self.hops.get(seq, {}), timeout
+            )
+
+    def latencies(self, start, end):
+        with self.lock:
+            return sorted(
+                (hops[end] - hops[start]) * 1000
+                for hops in self.hops.values()
+                if start in hops and end in hops
+            )
+
+
+# -------------------------------------------------------------------------- #
+# In-process devices
+# -------------------------------------------------------------------------- #
+
+
+class SimMacropad:
+    """The macropad as hidapi sees it: RGB_SEND reports arrive on the next IN poll"""
+
+    def __init__(self, trace, usb_interval):
+        self.trace = trace
+        self.usb_interval = usb_interval
+        self.reports = queue.Queue()
+        self.start = now()
+
+    def send_rgb(self, seq, layer):
+        timer_ms = int((now() - self.start) * 1000)
+        self.trace.mark(seq, "sent")
+        report = proto.encode_rgb_send(layer, seq, timer_ms)
+        self.reports.put((next_poll(self.usb_interval), report))
+
+    def read(self, length, timeout_ms=0):
+        try:
+            deliver_at, report = self.reports.get(timeout=timeout_ms / 1000)
+        except queue.Empty:
+            return []
+        sleep_until(deliver_at)
+        return list(report[:length])
+
+    def write(self, report):
+        return len(report)
+
+    def close(self):
+        pass
+
+
+class SimKeyboard:
+    """
+    The keyboard as hidapi sees it. A write completes on the next OUT poll,
+    the firmware applies the colour and its receipt goes out on the next IN
+    poll, where the client's reader hands it to receipt_listener.
+    """
+
+    def __init__(self, trace, usb_interval, keyboard_manager):
+        self.trace = trace
+        self.usb_interval = usb_interval
+        self.keyboard_manager = keyboard_manager
+        self.receipts = queue.Queue()
+        self.colour = None
+        threading.Thread(target=self._deliver_receipts, daemon=True).start()
+
+    def write(self, report):
+        data = bytes(report[1:])  # strip the report number like the kernel does
+        sleep_until(next_poll(self.usb_interval))
+
+        # raw_hid_receive(): rgblight_sethsv(colour_map[data[0]]), then the receipt
+        self.colour = data[0]
+        seq, _ = proto.decode_rgb_tag(data[1:7])
+        self.trace.mark(seq, "applied")
+
+        receipt = bytes([proto.RGB_RECEIPT]) + data[:7]
+        self.receipts.put(receipt.ljust(proto.REPORT_LENGTH, b"\0"))
+        return len(report)
+
+    def _deliver_receipts(self):
+        while True:
+            receipt = self.receipts.get()
+            sleep_until(next_poll(self.usb_interval))
+            self.keyboard_manager._on_keyboard_report(list(receipt))
+
+    def read(self, length, timeout_ms=0):
+        return []
+
+    def close(self):
+        pass
+
+
+# -------------------------------------------------------------------------- #
+# Virtual kernel devices
+# -------------------------------------------------------------------------- #
+
+
+class UhidMacropad:
+    def __init__(self, trace):
+        self.trace = trace
+        self.device = hidraw.UhidDevice(
+            "macropad benchmark", UHID_VENDOR_ID, UHID_MACROPAD_PRODUCT_ID
+        )
+        self.start = now()
+
+    def send_rgb(self, seq, layer):
+        timer_ms = int((now() - self.start) * 1000)
+        self.trace.mark(seq, "sent")
+        self.device.send_input(proto.encode_rgb_send(layer, seq, timer_ms))
+
+    def close(self):
+        self.device.close()
+
+
+class UhidKeyboard:
+    """Plays keyboard firmware: applies each colour and echoes a receipt"""
+
+    def __init__(self, trace):
+        self.trace = trace
+        self.device = hidraw.UhidDevice(
+            "keyboard benchmark", UHID_VENDOR_ID, UHID_KEYBOARD_PRODUCT_ID
+        )
+        self.running = True
+        threading.Thread(target=self._run, daemon=True).start()
+
+    def _run(self):
+        while self.running:
+            data = self.device.read_output(timeout=0.1)
+            if not data:
+                continue
+            seq, _ = proto.decode_rgb_tag(data[1:7])
+            self.trace.mark(seq, "applied")
+            receipt = bytes([proto.RGB_RECEIPT]) + bytes(data[:7])
+            self.device.send_input(receipt.ljust(proto.REPORT_LENGTH, b"\0"))
+
+    def close(self):
+        self.running = False
+        self.device.close()
+
+
+# -------------------------------------------------------------------------- #
+# Layer change benchmark
+# -------------------------------------------------------------------------- #
+
+
+def open_devices(trace, args, keyboard_manager):
+    """Returns (macropad, macropad interface for the reactor, keyboard)"""
+    if not args.uhid:
+        macropad = SimMacropad(trace, args.usb_interval / 1000)
+        keyboard = SimKeyboard(trace, args.usb_interval / 1000, keyboard_manager)
+        keyboard_manager.keyboard_device = keyboard
+        return macropad, macropad, keyboard
+
+    client.HID_BACKEND = "hidraw"
+
+    macropad = UhidMacropad(trace)
+    keyboard = UhidKeyboard(trace)
+    for product_id in (UHID_MACROPAD_PRODUCT_ID, UHID_KEYBOARD_PRODUCT_ID):
+        if not hidraw.wait_for_device(
+            UHID_VENDOR_ID, product_id, client.usage_page, client.usage
+        ):
+            raise RuntimeError("hidraw node for a uhid device never appeared")
+
+    macropad_config = {"vendor_id": UHID_VENDOR_ID, "product_id": UHID_MACROPAD_PRODUCT_ID}
+    return macropad, client.get_raw_hid_interface(macropad_config), keyboard
+
+
+def run_layers(args):
+    trace = Trace()
+    keyboard_manager = client.KeyboardManager(UHID_VENDOR_ID, UHID_KEYBOARD_PRODUCT_ID)
+    macropad, interface, keyboard = open_devices(trace, args, keyboard_manager)
+
+    reactor = client.HidReactor(interface, keyboards=[keyboard_manager])
+    forward_rgb = reactor.handlers[client.RGB_SEND]
+
+    def traced_forward(report):
+        seq, _ = proto.decode_rgb_tag(report[proto.RGB_TAG])
+        trace.mark(seq, "read")
+        forward_rgb(report)
+
+    reactor.handlers[client.RGB_SEND] = traced_forward
+    reactor.start()
+
+    send_layer_data = keyboard_manager.send_layer_data
+
+    def traced_send(layer_data, tag=b""):
+        if tag:
+            trace.mark(proto.decode_rgb_tag(tag)[0], "written")
+        return send_layer_data(layer_data, tag)
+
+    keyboard_manager.send_layer_data = traced_send
+    keyboard_manager.receipt_listener = lambda report: trace.mark(
+        proto.decode_receipt(report)[1], "receipt"
+    )
+
+    superseded_before = keyboard_manager.superseded
+
+    try:
+        # warm up threads and the connection before timing
+        macropad.send_rgb(0, 0)
+        trace.wait_for(0, 2.0)
+        trace.hops.clear()
+
+        started = now()
+        for i in range(args.count):
+            seq = i + 1
+            macropad.send_rgb(seq, seq % NUM_LAYERS)
+            if args.interval:
+                sleep_until(started + seq * args.interval / 1000)
+            else:
+                trace.wait_for(seq, 1.0)
+
+        trace.wait_for(args.count, 1.0)
+        time.sleep(0.05)
+    finally:
+        reactor.stop()
+        macropad.close()
+        keyboard.close()
+
+    superseded = keyboard_manager.superseded - superseded_before
+    receipts = len(trace.latencies("sent", "receipt"))
+
+    pacing = f"every {args.interval} ms" if args.interval else "back to back"
+    print(
+        f"{args.count} layer changes ({pacing}, "
+        f"{'uhid' if args.uhid else f'simulated {args.usb_interval} ms USB polling'})"
+    )
+    print(
+        f"{receipts} receipts, {superseded} colours superseded in the keyboard mailbox, "
+        f"{reactor.stats()['misrouted']} misrouted reports"
+    )
+    print()
+    print(f"{'hop (ms)':<32}{'p50':>9}{'p99':>9}{'max':>9}")
+
+    rows = [(f"{a} -> {b}", a, b) for a, b in zip(HOPS, HOPS[1:])]
+    rows += [("layer change (sent -> applied)", "sent", "applied")]
+    rows += [("round trip (sent -> receipt)", "sent", "receipt")]
+
+    for label, start, end in rows:
+        values = trace.latencies(start, end)
+        if not values:
+            print(f"{label:<32}{'-':>9}{'-':>9}{'-':>9}")
+            continue
+        print(
+            f"{label:<32}{percentile(values, 0.5):>9.3f}"
+            f"{percentile(values, 0.99):>9.3f}{values[-1]:>9.3f}"
+        )
+
+
+# -------------------------------------------------------------------------- #
+# Image upload benchmark
+# -------------------------------------------------------------------------- #
+
+IMAGE_SLOT_COUNT = 4
+IMAGE_WRITE_CHUNK = 16
+SCAN_INTERVAL = 0.001  # seconds per matrix scan, image_slots_task() runs once per scan
+
+
+class ImageSlotFirmware:
+    """image_slots_receive() and image_slots_task() of image_slots.c"""
+
+    def __init__(self, eeprom_chunk):
+        self.eeprom_chunk = eeprom_chunk
+        self.slots = [None] * IMAGE_SLOT_COUNT
+        self.upload = None
+        self.received = bytearray()
+        self.busy_until = 0
+
+    def status(self, slot, code, size=0):
+        valid = sum(1 << i for i, data in enumerate(self.slots) if data is not None)
+        report = bytes([proto.IMAGE_STATUS, slot, code, IMAGE_SLOT_COUNT, valid, size & 0xFF, size >> 8])
+        return report.ljust(proto.REPORT_LENGTH, b"\0")
+
+    def receive(self, data):
+        """Returns (seconds until the answer goes out, answer) or None"""
+        if data[0] != proto.IMAGE_UPLOAD:
+            return None
+        op = data[1]
+        busy = now() < self.busy_until
+
+        if op == proto.IMAGE_OP_BEGIN:
+            slot, length, crc = data[2], data[3] | (data[4] << 8), data[5] | (data[6] << 8)
+            if busy:
+                return 0, self.status(slot, proto.IMAGE_ERR_BUSY)
+            if slot >= IMAGE_SLOT_COUNT:
+                return 0, self.status(slot, proto.IMAGE_ERR_SLOT)
+            if not 0 < length <= bitmaps.SLOT_DATA_SIZE:
+                return 0, self.status(slot, proto.IMAGE_ERR_LENGTH)
+            self.upload = (slot, length, crc)
+            self.received = bytearray()
+            return 0, self.status(slot, proto.IMAGE_OK)
+
+        if op == proto.IMAGE_OP_DATA and self.upload:
+            offset, n = data[2] | (data[3] << 8), data[4]
+            if offset != len(self.received):
+                self.upload = None
+                return None
+            self.received += data[5 : 5 + n]
+            return None
+
+        if op == proto.IMAGE_OP_COMMIT:
+            if self.upload is None or len(self.received) != self.upload[1]:
+                self.upload = None
+                return 0, self.status(0, proto.IMAGE_ERR_SEQUENCE)
+            slot, length, crc = self.upload
+            self.upload = None
+            if proto.crc16(self.received) != crc:
+                return 0, self.status(slot, proto.IMAGE_ERR_CRC)
+
+            # one chunk written per scan, then one chunk read back per scan
+            chunks = math.ceil(length / IMAGE_WRITE_CHUNK)
+            delay = chunks * (SCAN_INTERVAL + self.eeprom_chunk) + chunks * SCAN_INTERVAL
+            self.busy_until = now() + delay
+            self.slots[slot] = bytes(self.received)
+            return delay, self.status(slot, proto.IMAGE_OK, length)
+
+        if op == proto.IMAGE_OP_ERASE:
+            self.slots[data[2]] = None
+            return 0, self.status(data[2], proto.IMAGE_OK)
+
+        return None
+
+
+class SimImageMacropad:
+    """The macropad as hidapi sees it, answers go out on the next IN poll"""
+
+    def __init__(self, firmware, usb_interval):
+        self.firmware = firmware
+        self.usb_interval = usb_interval
+        self.reports = queue.Queue()
+
+    def write(self, report):
+        sleep_until(next_poll(self.usb_interval))
+        answer = self.firmware.receive(bytes(report[1:]))
+        if answer:
+            delay, report_in = answer
+            self.reports.put((next_poll(self.usb_interval) + delay, report_in))
+        return len(report)
+
+    def read(self, length, timeout_ms=0):
+        try:
+            deliver_at, report = self.reports.get(timeout=timeout_ms / 1000)
+        except queue.Empty:
+            return []
+        sleep_until(deliver_at)
+        return list(report[:length])
+
+    def close(self):
+        pass
+
+
+class UhidImageMacropad:
+    def __init__(self, firmware):
+        self.firmware = firmware
+        self.device = hidraw.UhidDevice(
+            "macropad benchmark", UHID_VENDOR_ID, UHID_MACROPAD_PRODUCT_ID
+        )
+        self.running = True
+        threading.Thread(target=self._run, daemon=True).start()
+
+    def _run(self):
+        while self.running:
+            data = self.device.read_output(timeout=0.1)
+            if not data:
+                continue
+            answer = self.firmware.receive(bytes(data))
+            if answer:
+                delay, report = answer
+                time.sleep(delay)
+                self.device.send_input(report)
+
+    def close(self):
+        self.running = False
+        self.device.close()
+
+
+def run_images(args):
+    paths = args.images or sorted(glob.glob("images/*.pbm"))
+    if not paths:
+        raise SystemExit("no images given and none in images/")
+    images = [(bitmaps.image_name(path), bitmaps.read_image(path)) for path in paths]
+
+    firmware = ImageSlotFirmware(args.eeprom_ms / 1000)
+    if args.uhid:
+        client.HID_BACKEND = "hidraw"
+        macropad = UhidImageMacropad(firmware)
+        if not hidraw.wait_for_device(
+            UHID_VENDOR_ID, UHID_MACROPAD_PRODUCT_ID, client.usage_page, client.usage
+        ):
+            raise RuntimeError("hidraw node for a uhid device never appeared")
+        interface = client.get_raw_hid_interface(
+            {"vendor_id": UHID_VENDOR_ID, "product_id": UHID_MACROPAD_PRODUCT_ID}
+        )
+    else:
+        macropad = interface = SimImageMacropad(firmware, args.usb_interval / 1000)
+
+    reactor = client.HidReactor(interface).start()
+    times = []
+    failures = 0
+    payload = reports = 0
+
+    try:
+        for i in range(args.count):
+            name, pages = images[i % len(images)]
+            data = bitmaps.encode_for_slot(pages)
+            slot = i % IMAGE_SLOT_COUNT
+
+            started = now()
+            status = bitmaps.upload(reactor, slot, data, client.get_report)
+            elapsed = now() - started
+
+            ok = status is not None and status[1] == proto.IMAGE_OK
+            if not ok or bitmaps.decode(firmware.slots[slot]) != pages:
+                failures += 1
+                continue
+            times.append(elapsed * 1000)
+            payload += len(data)
+            reports += len(proto.encode_image_upload(slot, data))
+    finally:
+        reactor.stop()
+        macropad.close()
+
+    times.sort()
+    transport = "uhid" if args.uhid else f"simulated {args.usb_interval} ms USB polling"
+    print(
+        f"{args.count} uploads of {len(images)} images ({transport}, "
+        f"{args.eeprom_ms} ms per {IMAGE_WRITE_CHUNK} byte EEPROM write)"
+    )
+    if not times:
+        print(f"{failures} failed uploads")
+        return
+
+    uploads = len(times)
+    total = sum(times) / 1000
+    print(
+        f"{failures} failed, {payload / uploads:.0f} bytes and "
+        f"{reports / uploads:.1f} reports per image on average"
+    )
+    print()
+    print(f"{'upload (ms)':<32}{'p50':>9}{'p99':>9}{'max':>9}")
+    print(
+        f"{'BEGIN -> verified':<32}{percentile(times, 0.5):>9.3f}"
+        f"{percentile(times, 0.99):>9.3f}{times[-1]:>9.3f}"
+    )
+    print()
+    print(f"throughput: {payload / total:.0f} B/s compressed, {uploads * bitmaps.BITMAP_SIZE / total:.0f} B/s of pixels")
+
+
+# -------------------------------------------------------------------------- #
+# Frame streaming benchmark
+# -------------------------------------------------------------------------- #
+
+
+class StreamFirmware:
+    """frame_stream_receive() of frame_stream.c"""
+
+    def __init__(self):
+        self.frame = bytearray(stream.FRAME_SIZE)
+        self.oled = bytearray(stream.FRAME_SIZE)
+        self.changed = set()
+        self.shown = 0
+
+    def receive(self, data):
+        if data[0] != proto.FRAME_STREAM:
+            return
+        op = data[1]
+        if op == proto.FRAME_OP_START:
+            self.frame = bytearray(stream.FRAME_SIZE)
+            self.oled = bytearray(stream.FRAME_SIZE)
+            self.changed.clear()
+        elif op in (proto.FRAME_OP_RAW, proto.FRAME_OP_RLE):
+            offset, n = data[2] | (data[3] << 8), data[4]
+            payload = data[5 : 5 + n]
+            if op == proto.FRAME_OP_RLE:
+                payload = bitmaps.decode(payload, stream.FRAME_SIZE - offset)
+            self.frame[offset : offset + len(payload)] = payload
+            first = offset // stream.TILE_SIZE
+            last = (offset + len(payload) - 1) // stream.TILE_SIZE
+            self.changed.update(range(first, last + 1))
+        elif op == proto.FRAME_OP_END:
+            for tile in self.changed:
+                start = tile * stream.TILE_SIZE
+                self.oled[start : start + stream.TILE_SIZE] = self.frame[start : start + stream.TILE_SIZE]
+            self.changed.clear()
+            self.shown += 1
+
+
+class SimStreamMacropad:
+    """Each report written completes on the next OUT poll"""
+
+    def __init__(self, firmware, usb_interval):
+        self.firmware = firmware
+        self.usb_interval = usb_interval
+
+    def write(self, report):
+        sleep_until(next_poll(self.usb_interval))
+        self.firmware.receive(bytes(report[1:]))
+        return len(report)
+
+
+def frames_clock(count):
+    """Two 8x8 digits change every frame, like a seconds counter"""
+    frame = bytearray(stream.FRAME_SIZE)
+    frame[0 : stream.WIDTH] = b"\x01" * stream.WIDTH  # a rule along the top
+    for i in range(count):
+        digit = bytes(random.randrange(256) for _ in range(16))
+        frame[2 * stream.WIDTH + 96 : 2 * stream.WIDTH + 112] = digit
+        yield bytes(frame)
+
+
+def frames_sprite(count):
+    """An 8x8 box moving 3 pixels per frame"""
+    for i in range(count):
+        frame = bytearray(stream.FRAME_SIZE)
+        x = (i * 3) % (stream.WIDTH - 8)
+        page = 3 + (i // 40) % 4
+        frame[page * stream.WIDTH + x : page * stream.WIDTH + x + 8] = b"\xFF" * 8
+        yield bytes(frame)
+
+
+def frames_graph(count):
+    """A bar graph scrolling across the bottom five pages"""
+    heights = [0] * stream.WIDTH
+    for i in range(count):
+        heights = heights[1:] + [random.randrange(41)]
+        frame = bytearray(stream.FRAME_SIZE)
+        for x, height in enumerate(heights):
+            column = ((1 << height) - 1) << (stream.HEIGHT - height)
+            for page in range(3, 8):
+                frame[page * stream.WIDTH + x] = (column >> (page * 8)) & 0xFF
+        yield bytes(frame)
+
+
+def frames_noise(count):
+    """Every pixel random, every tile changes"""
+    for i in range(count):
+        yield bytes(random.randrange(256) for _ in range(stream.FRAME_SIZE))
+
+
+STREAM_SCENES = {
+    "clock": frames_clock,
+    "sprite": frames_sprite,
+    "graph": frames_graph,
+    "noise": frames_noise,
+}
+
+
+def run_stream(args):
+    random.seed(1)
+    full_frame = math.ceil(stream.FRAME_SIZE / proto.FRAME_DATA_CHUNK) + 1
+
+    print(
+        f"{args.frames} frames per scene, sent back to back "
+        f"(simulated {args.usb_interval} ms USB polling), a full frame is {full_frame} reports"
+    )
+    print()
+    print(f"{'scene':<10}{'encoding':<10}{'fps':>8}{'tiles':>8}{'reports':>9}{'bytes':>8}{'mismatch':>10}")
+
+    for scene, make_frames in STREAM_SCENES.items():
+        frames = list(make_frames(args.frames))
+        for rle in (False, True):
+            firmware = StreamFirmware()
+            macropad = SimStreamMacropad(firmware, args.usb_interval / 1000)
+            encoder = stream.FrameEncoder(rle=rle)
+
+            for report in encoder.start():
+                macropad.write(client.get_report(report))
+
+            mismatches = 0
+            started = now()
+            for frame in frames:
+                for report in encoder.encode(frame):
+                    macropad.write(client.get_report(report))
+                if firmware.oled != frame:
+                    mismatches += 1
+            elapsed = now() - started
+
+            stats = encoder.stats()
+            print(
+                f"{scene:<10}{'rle' if rle else 'raw':<10}{len(frames) / elapsed:>8.1f}"
+                f"{stats['tiles']:>8.1f}{stats['reports']:>9.1f}{stats['bytes']:>8.0f}{mismatches:>10}"
+            )
+
+
+# -------------------------------------------------------------------------- #
+# Album art benchmark
+# -------------------------------------------------------------------------- #
+
+
+def dither_python(gray):
+    """The per pixel loop the numpy dither replaces, for comparison"""
+    lit = [[False] * album_art.WIDTH for _ in range(album_art.HEIGHT)]
+    for y in range(album_art.HEIGHT):
+        for x in range(album_art.WIDTH):
+            threshold = (album_art.BAYER_8[y % 8][x % 8] + 0.5) * 255 / 64
+            lit[y][x] = gray[y][x] > threshold
+    return bitmaps.pixels_to_pages(lit)
+
+
+def time_ms(function, count):
+    """Sorted milliseconds of count calls"""
+    times = []
+    for _ in range(count):
+        started = now()
+        function()
+        times.append((now() - started) * 1000)
+    return sorted(times)
+
+
+def run_art(args):
+    if not album_art.AVAILABLE:
+        raise SystemExit("the art benchmark needs numpy and Pillow")
+
+    paths = args.images or sorted(glob.glob("images/*.pbm"))
+    if not paths:
+        raise SystemExit("no images given and none in images/")
+    files = {}
+    for path in paths:
+        with open(path, "rb") as f:
+            files[path] = f.read()
+
+    np = album_art.np
+    gray = np.random.default_rng(1).integers(0, 256, (album_art.HEIGHT, album_art.WIDTH), dtype=np.uint8)
+    if album_art.pack_pages(album_art.dither(gray)) != dither_python(gray.tolist()):
+        raise SystemExit("numpy and Python dithers disagree")
+
+    rows = []
+    for path, data in files.items():
+        rows.append((f"render {os.path.basename(path)}", time_ms(lambda: album_art.render(data), args.count)))
+    rows.append(("dither + pack, numpy", time_ms(lambda: album_art.pack_pages(album_art.dither(gray)), args.count)))
+    rows.append(("dither + pack, Python", time_ms(lambda: dither_python(gray.tolist()), max(1, args.count // 10))))
+
+    with tempfile.TemporaryDirectory() as cache_dir:
+        worker = album_art.AlbumArtWorker(cache_dir, fetch=lambda path: files[path])
+        ready = threading.Event()
+        worker.listeners.append(ready.set)
+
+        def track_change(track_id, path):
+            ready.clear()
+            worker.request(track_id, path)
+            ready.wait(5)
+
+        worker.load("cached", paths[0])
+        rows.append(("cache hit", time_ms(lambda: worker.load("cached", paths[0]), args.count)))
+
+        changes = []
+        sizes = []
+        for i in range(args.count):
+            started = now()
+            track_change(f"track{i}", paths[i % len(paths)])
+            changes.append((now() - started) * 1000)
+            sizes.append(len(worker.current[1] or b""))
+            track_change(None, None)
+        rows.append(("track change, uncached", sorted(changes)))
+
+    print(f"{len(paths)} images, {args.count} runs each")
+    print()
+    print(f"{'art (ms)':<32}{'p50':>9}{'p99':>9}{'max':>9}")
+    for label, values in rows:
+        print(
+            f"{label[:31]:<32}{percentile(values, 0.5):>9.3f}"
+            f"{percentile(values, 0.99):>9.3f}{values[-1]:>9.3f}"
+        )
+
+    reports = [len(proto.encode_image_upload(proto.IMAGE_SLOT_ALBUM_ART, bytes(size))) for size in sizes]
+    print()
+    print(
+        f"sent on a track change: {sum(sizes) / len(sizes):.0f} bytes in "
+        f"{sum(reports) / len(reports):.1f} reports, written from the HID loop"
+    )
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    layers = commands.add_parser("layers", help="layer change latency, macropad key to keyboard RGB")
+    layers.add_argument("--count", type=int, default=2000)
+    layers.add_argument(
+        "--interval", type=float, default=5.0,
+        help="ms between layer changes, 0 waits for each receipt",
+    )
+    layers.add_argument(
+        "--usb-interval", type=float, default=1.0,
+        help="ms between polls of the simulated interrupt endpoints",
+    )
+    layers.add_argument("--uhid", action="store_true", help="use virtual kernel devices")
+    layers.set_defaults(run=run_layers)
+
+    images = commands.add_parser("images", help="image slot upload time and throughput")
+    images.add_argument("images", nargs="*", help="defaults to images/*.pbm")
+    images.add_argument("--count", type=int, default=50)
+    images.add_argument(
+        "--usb-interval", type=float, default=1.0,
+        help="ms between polls of the simulated interrupt endpoints",
+    )
+    images.add_argument(
+        "--eeprom-ms", type=float, default=0.5,
+        help="ms the firmware spends on each EEPROM chunk write",
+    )
+    images.add_argument("--uhid", action="store_true", help="use a virtual kernel device")
+    images.set_defaults(run=run_images)
+
+    stream_cmd = commands.add_parser("stream", help="framebuffer streaming frame rate and bytes per frame")
+    stream_cmd.add_argument("--frames", type=int, default=200)
+    stream_cmd.add_argument(
+        "--usb-interval", type=float, default=1.0,
+        help="ms between polls of the simulated interrupt endpoint",
+    )
+    stream_cmd.set_defaults(run=run_stream)
+
+    art = commands.add_parser("art", help="cover art decode, dither and cache cost")
+    art.add_argument("images", nargs="*", help="defaults to images/*.pbm")
+    art.add_argument("--count", type=int, default=50)
+    art.set_defaults(run=run_art)
+
+    args = parser.parse_args()
+    args.run(args)
+
+
+if __name__ == "__main__":
+    main()
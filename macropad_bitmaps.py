@@ -0,0 +1,422 @@
+"""
+Converts images for the arrows layer into the compressed bitmaps.c and
+bitmaps.h the firmware is built with.
+
+    python macropad_bitmaps.py build [IMAGE ...] [--out DIR]
+    python macropad_bitmaps.py extract OLD_BITMAPS_C [--out DIR]
+    python macropad_bitmaps.py upload SLOT IMAGE [--macropad N]
+    python macropad_bitmaps.py erase SLOT [--macropad N]
+
+build: IMAGE defaults to images/*.pbm. PBM files are read directly, anything
+else needs Pillow and is scaled to 128x48 and thresholded. Each image is named
+after its file.
+
+extract: writes the raw 768 byte arrays of an old style bitmaps.c (such as
+image2cpp output) to PBM files, so they can be built again.
+
+upload: sends an image to one of the macropad's EEPROM image slots over raw
+HID, where the arrows layer picks from it along with the built in images. The
+macropad writes and verifies the slot in the background and answers once it
+is done. erase empties a slot. --macropad picks an entry of MACROPADS in
+macropad_client_hid.py, stop the client first so it isn't reading the reports.
+
+Images are stored in OLED page order (byte i is column i % 128 of page
+i // 128, least significant bit at the top) and compressed with a run length
+encoding tuned for 1bpp pages. Every run starts with a control byte whose top
+two bits are the op and whose low six bits are n:
+
+    00  literal, the next n + 1 bytes are copied
+    01  repeat, the next byte is written n + 2 times
+    10  n + 1 bytes of 0x00 (all pixels off)
+    11  n + 1 bytes of 0xFF (all pixels on)
+
+bitmap_rle.c decodes this straight into the OLED buffer.
+"""
+
+import argparse
+import glob
+import os
+import queue
+import re
+import sys
+
+import macropad_protocol as proto
+
+WIDTH = 128
+HEIGHT = 48
+BITMAP_SIZE = WIDTH * HEIGHT // 8
+
+OP_LITERAL = 0x00
+OP_REPEAT = 0x40
+OP_ZEROS = 0x80
+OP_ONES = 0xC0
+MAX_COUNT = 64
+
+# IMAGE_SLOT_DATA_SIZE in image_slots.h
+SLOT_DATA_SIZE = BITMAP_SIZE + BITMAP_SIZE // MAX_COUNT
+UPLOAD_TIMEOUT = 2.0  # seconds to wait for each IMAGE_STATUS
+
+PBM_TOKEN = re.compile(rb"\s*(#[^\n]*\n\s*)*(\S+)")
+
+HEADER = "// Generated by macropad_bitmaps.py, don't edit by hand\n"
+
+
+# -------------------------------------------------------------------------- #
+# Compression
+# -------------------------------------------------------------------------- #
+
+
+def encode(data):
+    """RLE compress OLED page bytes, see the module docstring for the format"""
+    out = bytearray()
+    literal = bytearray()
+
+    def flush_literal():
+        while literal:
+            chunk = literal[:MAX_COUNT]
+            out.append(OP_LITERAL | (len(chunk) - 1))
+            out.extend(chunk)
+            del literal[: len(chunk)]
+
+    i = 0
+    while i < len(data):
+        value = data[i]
+        run = 1
+        while i + run < len(data) and data[i + run] == value:
+            run += 1
+        i += run
+
+        if value in (0x00, 0xFF):
+            flush_literal()
+            op = OP_ZEROS if value == 0x00 else OP_ONES
+            while run:
+                count = min(run, MAX_COUNT)
+                out.append(op | (count - 1))
+                run -= count
+        elif run >= 3:
+            flush_literal()
+            while run >= 2:
+                count = min(run, MAX_COUNT + 1)
+                out.extend((OP_REPEAT | (count - 2), value))
+                run -= count
+            literal.extend([value] * run)
+        else:
+            literal.extend([value] * run)
+
+    flush_literal()
+    return bytes(out)
+
+
+def encode_literal(data):
+    """Literal runs only, never larger than SLOT_DATA_SIZE"""
+    out = bytearray()
+    for i in range(0, len(data), MAX_COUNT):
+        chunk = data[i : i + MAX_COUNT]
+        out.append(OP_LITERAL | (len(chunk) - 1))
+        out.extend(chunk)
+    return bytes(out)
+
+
+def encode_for_slot(data):
+    """encode(), unless noise made it too big for an image slot"""
+    compressed = encode(data)
+    return compressed if len(compressed) <= SLOT_DATA_SIZE else encode_literal(data)
+
+
+def decode(data, size=BITMAP_SIZE):
+    """Inverse of encode(), stops after size bytes like the firmware does"""
+    out = bytearray()
+    pos = 0
+    while len(out) < size and pos < len(data):
+        control = data[pos]
+        op, n = control & 0xC0, control & 0x3F
+        pos += 1
+        if op == OP_LITERAL:
+            out.extend(data[pos : pos + n + 1])
+            pos += n + 1
+        elif op == OP_REPEAT:
+            out.extend([data[pos]] * (n + 2))
+            pos += 1
+        else:
+            out.extend([0x00 if op == OP_ZEROS else 0xFF] * (n + 1))
+    return bytes(out[:size])
+
+
+# -------------------------------------------------------------------------- #
+# Image files
+# -------------------------------------------------------------------------- #
+
+
+def pixels_to_pages(pixels):
+    """Rows of lit (truthy) pixels, HEIGHT x WIDTH, to OLED page bytes"""
+    pages = bytearray(BITMAP_SIZE)
+    for y in range(HEIGHT):
+        for x in range(WIDTH):
+            if pixels[y][x]:
+                pages[(y // 8) * WIDTH + x] |= 1 << (y % 8)
+    return bytes(pages)
+
+
+def pages_to_pixels(pages):
+    return [
+        [(pages[(y // 8) * WIDTH + x] >> (y % 8)) & 1 for x in range(WIDTH)]
+        for y in range(HEIGHT)
+    ]
+
+
+def _pbm_tokens(data):
+    """Header tokens of a PBM file and the offset just after them"""
+    tokens = []
+    pos = 0
+    while len(tokens) < 3:
+        match = PBM_TOKEN.match(data, pos)
+        tokens.append(match.group(2))
+        pos = match.end()
+    return tokens, pos + 1
+
+
+def read_pbm(path):
+    """Rows of lit pixels. PBM black is an unlit OLED pixel."""
+    with open(path, "rb") as f:
+        data = f.read()
+
+    (magic, width, height), pos = _pbm_tokens(data)
+    width, height = int(width), int(height)
+    if (width, height) != (WIDTH, HEIGHT):
+        raise ValueError(f"{path} is {width}x{height}, images must be {WIDTH}x{HEIGHT}")
+
+    if magic == b"P4":
+        row_bytes = (width + 7) // 8
+        rows = [data[pos + y * row_bytes : pos + (y + 1) * row_bytes] for y in range(height)]
+        return [[not ((row[x // 8] >> (7 - x % 8)) & 1) for x in range(width)] for row in rows]
+    if magic == b"P1":
+        bits = re.findall(rb"[01]", data[pos - 1 :])
+        return [[bits[y * width + x] == b"0" for x in range(width)] for y in range(height)]
+    raise ValueError(f"{path} is not a PBM file")
+
+
+def write_pbm(path, pixels):
+    with open(path, "wb") as f:
+        f.write(f"P4\n{WIDTH} {HEIGHT}\n".encode())
+        for row in pixels:
+            packed = bytearray((WIDTH + 7) // 8)
+            for x, lit in enumerate(row):
+                if not lit:
+                    packed[x // 8] |= 0x80 >> (x % 8)
+            f.write(packed)
+
+
+def read_image(path):
+    """OLED page bytes of any image file"""
+    if path.lower().endswith(".pbm"):
+        return pixels_to_pages(read_pbm(path))
+
+    from PIL import Image  # only needed for formats other than PBM
+
+    with Image.open(path) as image:
+        image = image.convert("L").resize((WIDTH, HEIGHT))
+        pixels = [
+            [image.getpixel((x, y)) >= 128 for x in range(WIDTH)] for y in range(HEIGHT)
+        ]
+    return pixels_to_pages(pixels)
+
+
+def image_name(path):
+    return re.sub(r"\W", "_", os.path.splitext(os.path.basename(path))[0]).lower()
+
+
+# -------------------------------------------------------------------------- #
+# C sources
+# -------------------------------------------------------------------------- #
+
+
+def c_array(name, data):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("\t" + " ".join(f"0x{b:02x}," for b in data[i : i + 16]))
+    return f"const unsigned char {name}[] PROGMEM = {{\n" + "\n".join(lines) + "\n};\n"
+
+
+def write_sources(images, out_dir):
+    """images is a list of (name, page bytes), returns the compressed sizes"""
+    sizes = []
+    arrays = []
+    for name, pages in images:
+        compressed = encode(pages)
+        assert decode(compressed) == pages, name
+        sizes.append(len(compressed))
+        arrays.append(f"// {name}: {len(compressed)} bytes, {BITMAP_SIZE} raw\n" + c_array(f"bitmap_{name}", compressed))
+
+    table = "".join(f"    bitmap_{name},\n" for name, _ in images)
+
+    with open(os.path.join(out_dir, "bitmaps.c"), "w", newline="\n") as f:
+        f.write(HEADER + '\n#include "bitmaps.h"\n#include QMK_KEYBOARD_H\n\n')
+        f.write("\n".join(arrays))
+        f.write(f"\nconst unsigned char * const bitmaps_arr[NUM_IMAGES] PROGMEM = {{\n{table}}};\n")
+
+    with open(os.path.join(out_dir, "bitmaps.h"), "w", newline="\n") as f:
+        f.write(
+            HEADER
+            + "\n#pragma once\n\n#include \"quantum.h\"\n\n"
+            + f"// images are {WIDTH}x{HEIGHT} pixels\n"
+            + f"#define BITMAP_SIZE {BITMAP_SIZE}\n"
+            + f"#define NUM_IMAGES {len(images)}\n\n"
+            + "// RLE compressed, draw them with bitmap_rle_draw()\n"
+            + "extern const unsigned char * const bitmaps_arr[NUM_IMAGES];\n"
+        )
+
+    return sizes
+
+
+def read_c_arrays(path):
+    """(name, bytes) of every PROGMEM array in a C file"""
+    with open(path) as f:
+        source = f.read()
+    arrays = re.findall(r"const unsigned char (\w+)\s*\[\] PROGMEM = \{(.*?)\};", source, re.S)
+    return [(name, bytes(int(x, 16) for x in re.findall(r"0x[0-9a-fA-F]+", body))) for name, body in arrays]
+
+
+# -------------------------------------------------------------------------- #
+# Image slots
+# -------------------------------------------------------------------------- #
+
+
+def wait_for_status(reactor, timeout=UPLOAD_TIMEOUT):
+    """decode_image_status() of the next IMAGE_STATUS report, None on timeout"""
+    try:
+        return proto.decode_image_status(reactor.image_statuses.get(timeout=timeout))
+    except queue.Empty:
+        return None
+
+
+def upload(reactor, slot, data, get_report):
+    """
+    Uploads RLE image data to a slot through a started HidReactor. Returns the
+    final decode_image_status(), None if the macropad stopped answering.
+    """
+    while not reactor.image_statuses.empty():
+        reactor.image_statuses.get_nowait()
+
+    begin, *rest = proto.encode_image_upload(slot, data)
+    reactor.write(get_report(begin))
+    status = wait_for_status(reactor)
+    if status is None or status[1] != proto.IMAGE_OK:
+        return status
+
+    for report in rest:
+        reactor.write(get_report(report))
+    return wait_for_status(reactor)
+
+
+def erase(reactor, slot, get_report):
+    reactor.write(get_report(proto.encode_image_erase(slot)))
+    return wait_for_status(reactor)
+
+
+def open_macropad(index):
+    """(client module, started HidReactor) for an entry of MACROPADS"""
+    stdout, stderr = sys.stdout, sys.stderr
+    import macropad_client_hid as client
+
+    # the client silences output for its .exe build
+    sys.stdout, sys.stderr = stdout, stderr
+
+    interface = client.get_raw_hid_interface(client.MACROPADS[index])
+    if interface is None:
+        raise SystemExit("macropad not found")
+    return client, client.HidReactor(interface).start()
+
+
+def print_status(status):
+    if status is None:
+        raise SystemExit("no answer from the macropad")
+
+    slot, code, count, valid, _ = status
+    used = ", ".join(str(i) for i in range(count) if valid & (1 << i)) or "none"
+    print(f"slot {slot}: {proto.IMAGE_STATUSES.get(code, f'status {code}')}, slots in use: {used}")
+    if code != proto.IMAGE_OK:
+        raise SystemExit(1)
+
+
+# -------------------------------------------------------------------------- #
+# Commands
+# -------------------------------------------------------------------------- #
+
+
+def run_build(args):
+    paths = args.images or sorted(glob.glob(os.path.join("images", "*.pbm")))
+    if not paths:
+        raise SystemExit("no images given and none in images/")
+
+    images = [(image_name(path), read_image(path)) for path in paths]
+    sizes = write_sources(images, args.out)
+
+    for (name, _), size in zip(images, sizes):
+        print(f"{name:<24}{size:>5} bytes")
+    raw = BITMAP_SIZE * len(images)
+    print(f"{'total':<24}{sum(sizes):>5} bytes, {raw} raw ({100 * sum(sizes) / raw:.0f}%)")
+
+
+def run_extract(args):
+    os.makedirs(args.out, exist_ok=True)
+    for name, data in read_c_arrays(args.source):
+        if len(data) != BITMAP_SIZE:
+            print(f"skipping {name}, {len(data)} bytes is not a raw image")
+            continue
+        name = name[len("bitmap_") :] if name.startswith("bitmap_") else name
+        path = os.path.join(args.out, f"{name}.pbm")
+        write_pbm(path, pages_to_pixels(data))
+        print(path)
+
+
+def run_upload(args):
+    data = encode_for_slot(read_image(args.image))
+    client, reactor = open_macropad(args.macropad)
+    try:
+        print(f"{image_name(args.image)}: {len(data)} bytes")
+        print_status(upload(reactor, args.slot, data, client.get_report))
+    finally:
+        reactor.stop()
+        reactor.interface.close()
+
+
+def run_erase(args):
+    client, reactor = open_macropad(args.macropad)
+    try:
+        print_status(erase(reactor, args.slot, client.get_report))
+    finally:
+        reactor.stop()
+        reactor.interface.close()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    build = commands.add_parser("build", help="write bitmaps.c and bitmaps.h")
+    build.add_argument("images", nargs="*")
+    build.add_argument("--out", default=".", help="directory for bitmaps.c and bitmaps.h")
+    build.set_defaults(run=run_build)
+
+    extract = commands.add_parser("extract", help="raw arrays of an old bitmaps.c to PBM files")
+    extract.add_argument("source")
+    extract.add_argument("--out", default="images")
+    extract.set_defaults(run=run_extract)
+
+    upload_cmd = commands.add_parser("upload", help="send an image to an EEPROM slot of the macropad")
+    upload_cmd.add_argument("slot", type=int)
+    upload_cmd.add_argument("image")
+    upload_cmd.add_argument("--macropad", type=int, default=0, help="index into MACROPADS")
+    upload_cmd.set_defaults(run=run_upload)
+
+    erase_cmd = commands.add_parser("erase", help="empty an EEPROM slot of the macropad")
+    erase_cmd.add_argument("slot", type=int)
+    erase_cmd.add_argument("--macropad", type=int, default=0, help="index into MACROPADS")
+    erase_cmd.set_defaults(run=run_erase)
+
+    args = parser.parse_args()
+    args.run(args)
+
+
+if __name__ == "__main__":
+    main()
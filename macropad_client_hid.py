@@ -5,8 +5,12 @@ import sys
 sys.stderr = sys.stdout = open(os.devnull, "wb")
 PRINT_ON = False
 
+import queue
 import threading
 import time
+from collections import deque
+from concurrent.futures import Future
+from concurrent.futures import TimeoutError as FutureTimeoutError
 from threading import Lock, RLock
 
 import hid
@@ -16,6 +20,11 @@ import spotipy
 from dotenv import load_dotenv
 from spotipy.oauth2 import SpotifyOAuth
 
+import macropad_album_art
+import macropad_hidraw as hidraw
+import macropad_hotplug
+import macropad_protocol as proto
+
 load_dotenv()
 
 macropad_vendor_id = 0xFEED
@@ -24,11 +33,43 @@ macropad_product_id = 0x9A25
 keyboard_vendor_id = 0x8968
 keyboard_product_id = 0x4C37
 
+# Every macropad and keyboard the client drives. Identical devices are told
+# apart by "index", their position among the devices with the same ids.
+# Layer colours from a macropad go to every keyboard in the same RGB sync
+# "group"; a macropad without a group keeps its colours to itself.
+MACROPADS = [
+    {
+        "vendor_id": macropad_vendor_id,
+        "product_id": macropad_product_id,
+        "index": 0,
+        "group": "desk",
+    },
+]
+KEYBOARDS = [
+    {
+        "vendor_id": keyboard_vendor_id,
+        "product_id": keyboard_product_id,
+        "index": 0,
+        "group": "desk",
+    },
+]
+
 usage_page = 0xFF60
 usage = 0x61
 
 report_length = 32
 
+# "hidapi" works everywhere. "hidraw" (Linux only) opens /dev/hidrawN directly
+# and waits on every device with one epoll loop instead of timed reads.
+HID_BACKEND = "hidapi"
+
+# Devices are (re)connected as soon as the system reports them plugged in.
+# Without hotplug events (not Linux) the client enumerates every
+# RECONNECT_INTERVAL seconds instead, and HOTPLUG_FALLBACK_INTERVAL is a
+# safety net in case an event is missed.
+RECONNECT_INTERVAL = 5
+HOTPLUG_FALLBACK_INTERVAL = 60
+
 PC_PERFORMANCE = 1
 NETWORK_SPEED = 2
 CURRENT_SONG = 3
@@ -38,10 +79,35 @@ TIMER_STATUS = 6
 TIMER_PAUSE_REQ = 7
 TIMER_RESTART_REQ = 8
 TIMER_RESET_REQ = 9
+SUBSCRIBE = 10
+KEYFRAME_REQ = 11
 COULD_NOT_CONNECT = -1
 
 SERVICE_INTERVAL = 1
-SONG_NAME_TRUNCATE = 20
+RESPONSE_TIMEOUT = 1.0  # seconds to wait for the macropad's answer to a message
+SONG_NAME_TRUNCATE = 20  # legacy protocol only, binary reports carry full names
+
+# "tlv" uses the binary protocol whenever the macropad answers the hello
+# handshake and falls back to the ASCII "digit + pipe-delimited" reports
+# otherwise. "legacy" always uses the ASCII reports.
+PROTOCOL_MODE = "tlv"
+HELLO_TIMEOUT = 1.0  # seconds to wait for the macropad's hello
+
+# With the binary protocol the firmware sends requests as soon as they happen
+# and the client pushes provider data only when it changes. Set to False to
+# fall back to the request/response loop.
+EVENT_DRIVEN = True
+PUSH_TICK = 0.1  # seconds between change checks in event mode
+
+# Send only the fields that changed since the last report, with a full
+# keyframe every KEYFRAME_INTERVAL seconds to recover from anything lost
+DELTA_MODE = True
+KEYFRAME_INTERVAL = 30
+
+# Show the playing track's cover art on the media layer (needs numpy and
+# Pillow). Converted art is kept in ALBUM_ART_CACHE_DIR by track id.
+ALBUM_ART = True
+ALBUM_ART_CACHE_DIR = "album_art_cache"
 
 
 SPOTIFY_CLIENT_ID = os.getenv("SPOTIFY_CLIENT_ID")
@@ -66,25 +132,51 @@ def load_pomodoro_time():
 pomodoro_duration = load_pomodoro_time()
 
 
+def _same_node(path, devname):
+    """Whether an open path (str or hidapi bytes) is the /dev node of a uevent"""
+    if isinstance(path, bytes):
+        path = path.decode("utf-8", "replace")
+    return bool(devname) and path.endswith("/" + devname.split("/")[-1])
+
+
 class KeyboardManager:
-    def __init__(self):
+    """
+    Forwards layer colours to the keyboard from its own thread. Callers post
+    into a single-slot mailbox, so a burst of layer changes collapses into the
+    newest one and the macropad reader never waits on the keyboard. The link
+    is assumed healthy until a write fails.
+    """
+
+    def __init__(self, vendor_id=keyboard_vendor_id, product_id=keyboard_product_id, index=0):
+        self.vendor_id = vendor_id
+        self.product_id = product_id
+        self.index = index
+
+        self.mailbox = None
+        self.mailbox_ready = threading.Condition()
+        self.superseded = 0  # colours replaced before they were written
+        self.worker = None
+        self.receipt_listener = None  # called with RGB receipts, see macropad_benchmark.py
+
         self.keyboard_device = None
+        self.keyboard_path = None
+        self.keyboard_lost = False
         self.keyboard_lock = Lock()
         self.last_connection_attempt = 0
-        self.connection_retry_delay = 2.0  # seconds
+        self.connection_retry_delay = 2.0  # seconds, without hotplug events
+        self.failed_generation = None
+        self.last_layer = None
+        self.last_tag = b""
+
+        hotplug.add_listener(self.on_hotplug)
 
     def _find_keyboard_interface(self):
         """Find the keyboard raw HID interface"""
         try:
-            keyboard_interfaces = hid.enumerate(keyboard_vendor_id, keyboard_product_id)
-            raw_hid_interfaces = [
-                i
-                for i in keyboard_interfaces
-                if i["usage_page"] == usage_page and i["usage"] == usage
-            ]
-
-            if raw_hid_interfaces:
-                return raw_hid_interfaces[0]["path"]
+            raw_hid_paths = find_raw_hid_paths(self.vendor_id, self.product_id)
+
+            if len(raw_hid_paths) > self.index:
+                return raw_hid_paths[self.index]
             return None
 
         except Exception as e:
@@ -92,13 +184,22 @@ class KeyboardManager:
             return None
 
     def _connect_keyboard(self):
-        """Establish connection to keyboard with persistent retry"""
-        current_time = time.time()
-
-        if (current_time - self.last_connection_attempt) < self.connection_retry_delay:
-            return False
+        """
+        Establish connection to keyboard. With hotplug events a failed attempt
+        is only repeated once a device was added or removed since.
+        """
+        generation = hotplug.generation
+
+        if hotplug.available:
+            if generation == self.failed_generation:
+                return False
+        else:
+            current_time = time.time()
+            if (current_time - self.last_connection_attempt) < self.connection_retry_delay:
+                return False
+            self.last_connection_attempt = current_time
 
-        self.last_connection_attempt = current_time
+        self.failed_generation = generation
 
         try:
             keyboard_path = self._find_keyboard_interface()
@@ -106,10 +207,16 @@ class KeyboardManager:
                 debug_print("Your keyboard raw HID interface was not found.")
                 return False
 
-            self.keyboard_device = hid.device()
-            self.keyboard_device.open_path(keyboard_path)
-            self.keyboard_device.set_nonblocking(1)  # Set non-blocking mode
+            self.keyboard_device = open_raw_hid(keyboard_path)
+            self.keyboard_path = keyboard_path
+            self.keyboard_lost = False
+            if HID_BACKEND == "hidraw":
+                # the loop notices an unplug, so writes need no probe read
+                hidraw_loop.register(
+                    self.keyboard_device, self._on_keyboard_report, self._on_keyboard_lost
+                )
 
+            self.failed_generation = None
             debug_print("Successfully connected to your keyboard.")
             return True
 
@@ -123,37 +230,62 @@ class KeyboardManager:
                 self.keyboard_device = None
             return False
 
-    def _is_keyboard_connected(self):
-        """Check if keyboard is still connected"""
-        if not self.keyboard_device:
-            return False
-
-        try:
-            self.keyboard_device.read(1, timeout_ms=0)
-            return True
-        except Exception:
-            return False
-
-    def send_layer_data(self, layer_data):
-        """Send layer data to keyboard with persistent connection and retry"""
+    def _on_keyboard_lost(self):
+        self.keyboard_lost = True
+
+    def _on_keyboard_report(self, report):
+        if report[0] == proto.RGB_RECEIPT and self.receipt_listener:
+            self.receipt_listener(report)
+
+    def post(self, layer_data, tag=b""):
+        """
+        Queue a colour for the keyboard, replacing any not yet written. tag is
+        the rest of the macropad's RGB_SEND (sequence, timestamp and colour),
+        passed through.
+        """
+        with self.mailbox_ready:
+            if self.mailbox is not None:
+                self.superseded += 1
+            self.mailbox = (layer_data, tag)
+            self.last_layer = layer_data
+            self.last_tag = tag
+            self.mailbox_ready.notify()
+
+            if self.worker is None or not self.worker.is_alive():
+                self.worker = threading.Thread(target=self._run, daemon=True)
+                self.worker.start()
+
+    def _run(self):
+        while True:
+            with self.mailbox_ready:
+                self.mailbox_ready.wait_for(lambda: self.mailbox is not None)
+                (layer_data, tag), self.mailbox = self.mailbox, None
+
+            self.send_layer_data(layer_data, tag)
+
+    def send_layer_data(self, layer_data, tag=b""):
+        """
+        Write layer data to the keyboard, reconnecting once if the write fails.
+        Never waits: if the keyboard is absent the layer is remembered and
+        sent when it is plugged back in.
+        """
         with self.keyboard_lock:
-            max_retries = 3
-            retry_count = 0
+            self.last_layer = layer_data
+            self.last_tag = tag
 
-            while retry_count < max_retries:
-                if not self.keyboard_device or not self._is_keyboard_connected():
+            if self.keyboard_lost:
+                self._disconnect_keyboard()
+
+            for attempt in range(2):
+                if not self.keyboard_device:
                     if not self._connect_keyboard():
-                        retry_count += 1
-                        if retry_count < max_retries:
-                            debug_print(
-                                f"Keyboard connection attempt {retry_count} failed, retrying..."
-                            )
-                            time.sleep(1)
-                        continue
+                        debug_print("Keyboard not connected, layer kept for when it is")
+                        return False
 
                 try:
                     report = [0x00] * (report_length + 1)
                     report[1] = layer_data
+                    report[2 : 2 + len(tag)] = tag
 
                     bytes_written = self.keyboard_device.write(bytes(report))
 
@@ -165,24 +297,38 @@ class KeyboardManager:
                     else:
                         debug_print("Failed to write data to keyboard")
                         self._disconnect_keyboard()
-                        retry_count += 1
 
                 except Exception as e:
                     debug_print(f"Error sending data to keyboard: {e}")
                     self._disconnect_keyboard()
-                    retry_count += 1
 
-            debug_print(f"Failed to send layer data after {max_retries} attempts")
+            debug_print("Failed to send layer data after reconnecting")
             return False
 
+    def on_hotplug(self, action, properties):
+        """Drop a removed keyboard at once, and bring a new one up to date"""
+        devname = properties.get("DEVNAME", "")
+
+        if action == "remove":
+            with self.keyboard_lock:
+                if self.keyboard_path and _same_node(self.keyboard_path, devname):
+                    debug_print("Keyboard unplugged")
+                    self._disconnect_keyboard()
+        elif action == "add" and self.keyboard_device is None:
+            if self.last_layer is not None:
+                self.post(self.last_layer, self.last_tag)
+
     def _disconnect_keyboard(self):
         """Safely disconnect from keyboard"""
         if self.keyboard_device:
+            if HID_BACKEND == "hidraw":
+                hidraw_loop.unregister(self.keyboard_device)
             try:
                 self.keyboard_device.close()
             except:
                 pass
             self.keyboard_device = None
+            self.keyboard_path = None
 
     def cleanup(self):
         """Cleanup keyboard connection"""
@@ -325,12 +471,12 @@ class PomodoroTimer:
             self.is_completed = False
             debug_print("Pomodoro timer reset")
 
-    def get_status(self):
-        """Get current timer status and remaining time"""
+    def get_state(self):
+        """Get current timer status and remaining time in seconds"""
         self.duration = load_pomodoro_time()
         with self.lock:
             if not self.start_time:
-                return "STOPPED", "00:00:00"
+                return "STOPPED", 0
 
             current_time = time.time()
 
@@ -350,19 +496,27 @@ class PomodoroTimer:
                 self.is_running = False
                 debug_print("Pomodoro timer completed!")
 
-            hours = int(remaining_time // 3600)
-            minutes = int((remaining_time % 3600) // 60)
-            seconds = int(remaining_time % 60)
-            time_str = f"{hours:02d}:{minutes:02d}:{seconds:02d}"
-
             if self.is_completed:
-                return "COMPLETED", "00:00:00"
+                return "COMPLETED", 0
             elif self.is_paused:
-                return "PAUSED", time_str
+                return "PAUSED", int(remaining_time)
             elif self.is_running:
-                return "RUNNING", time_str
+                return "RUNNING", int(remaining_time)
             else:
-                return "STOPPED", time_str
+                return "STOPPED", int(remaining_time)
+
+    def get_status(self):
+        """Get current timer status and remaining time as hh:mm:ss"""
+        status, remaining_time = self.get_state()
+        return status, self.format_remaining(remaining_time)
+
+    @staticmethod
+    def format_remaining(remaining_time):
+        hours = remaining_time // 3600
+        minutes = (remaining_time % 3600) // 60
+        seconds = remaining_time % 60
+
+        return f"{hours:02d}:{minutes:02d}:{seconds:02d}"
 
 
 class SpotifyManager:
@@ -409,13 +563,20 @@ class SpotifyManager:
 
             if current and current.get("is_playing"):
                 item = current["item"]
-                song_name = item["name"][:40]
-                artists = ", ".join([artist["name"] for artist in item["artists"]])[:40]
+                song_name = item["name"][: proto.SONG_TEXT_MAX]
+                artists = ", ".join([artist["name"] for artist in item["artists"]])[
+                    : proto.SONG_TEXT_MAX
+                ]
+
+                # converted on the album art thread, only when the track changes
+                images = item.get("album", {}).get("images", [])
+                album_art.request(item.get("id"), macropad_album_art.pick_image(images))
 
                 self.last_song_info = (song_name, artists)
                 self.last_update_time = current_time
                 return self.last_song_info
             else:
+                album_art.request(None, None)
                 self.last_song_info = None
                 self.last_update_time = current_time
                 return None
@@ -425,68 +586,281 @@ class SpotifyManager:
             return None
 
 
+class LinkState:
+    """Protocol features agreed with the connected macropad in the hello handshake"""
+
+    def __init__(self):
+        self.message_seq = 0
+        self.configure(None)
+
+    def configure(self, firmware):
+        self.firmware = firmware
+        self.tlv = (
+            PROTOCOL_MODE == "tlv"
+            and firmware is not None
+            and firmware.has(proto.CAP_TLV)
+            and firmware.report_size == report_length
+        )
+        self.event_driven = self.tlv and EVENT_DRIVEN and firmware.has(proto.CAP_EVENT_MODE)
+        self.delta = self.tlv and DELTA_MODE and firmware.has(proto.CAP_DELTA)
+        self.album_art = self.tlv and ALBUM_ART and firmware.has(proto.CAP_IMAGE_SLOTS)
+        # providers the firmware can't show are never sampled
+        self.providers = firmware.providers if self.tlv else proto.ALL_PROVIDERS
+
+        debug_print(f"Connected to {firmware or 'legacy firmware'}")
+
+
 # Global instances
+hotplug = macropad_hotplug.HotplugMonitor()
+hidraw_loop = hidraw.HidrawLoop()
 speed_tester = NetworkSpeedTester()
+album_art = macropad_album_art.AlbumArtWorker(ALBUM_ART_CACHE_DIR)
 spotify_manager = SpotifyManager()
-keyboard_manager = KeyboardManager()
 pomodoro_timer = PomodoroTimer()
 
+keyboard_managers = []
+rgb_groups = {}  # group name -> keyboard managers
+for keyboard_config in KEYBOARDS:
+    manager = KeyboardManager(
+        keyboard_config["vendor_id"],
+        keyboard_config["product_id"],
+        keyboard_config.get("index", 0),
+    )
+    keyboard_managers.append(manager)
+    rgb_groups.setdefault(keyboard_config.get("group"), []).append(manager)
+
+
+def find_raw_hid_paths(vendor_id, product_id):
+    """Paths of the raw HID interfaces of every matching device, in a stable order"""
+    if HID_BACKEND == "hidraw":
+        return hidraw.find_devices(vendor_id, product_id, usage_page, usage)
 
-def get_raw_hid_interface():
-    device_interfaces = hid.enumerate(macropad_vendor_id, macropad_product_id)
-    raw_hid_interfaces = [
-        i
-        for i in device_interfaces
+    return sorted(
+        i["path"]
+        for i in hid.enumerate(vendor_id, product_id)
         if i["usage_page"] == usage_page and i["usage"] == usage
-    ]
+    )
 
-    if len(raw_hid_interfaces) == 0:
-        return None
+
+def open_raw_hid(path):
+    if HID_BACKEND == "hidraw":
+        return hidraw.HidrawDevice(path)
 
     interface = hid.device()
-    interface.open_path(raw_hid_interfaces[0]["path"])
+    interface.open_path(path)
 
     interface.set_nonblocking(1)
 
     return interface
 
 
+def get_raw_hid_interface(config):
+    raw_hid_paths = find_raw_hid_paths(config["vendor_id"], config["product_id"])
+
+    index = config.get("index", 0)
+    if len(raw_hid_paths) <= index:
+        return None
+
+    return open_raw_hid(raw_hid_paths[index])
+
+
 def get_report(data):
     request_data = [0x00] * (report_length + 1)
     request_data[1 : len(data) + 1] = data
     return bytes(request_data)
 
 
-def send_report_with_timeout(interface, request_report):
-    if interface is None:
-        debug_print("No device found")
-        return COULD_NOT_CONNECT
+class HidReactor:
+    """
+    The only reader of the macropad interface. Each incoming report is
+    dispatched by its type: RGB_SEND goes to the keyboard, IMAGE_STATUS to
+    image_statuses for an upload in progress, anything else
+    answers the oldest pending request, or goes to on_request when nothing is
+    waiting (event mode). An answer that turns up after its request timed out
+    but before the next request is written is dropped rather than handed to
+    the next request. Reports nobody wanted are counted as misrouted.
+    """
 
-    debug_print("Request:")
-    debug_print(request_report)
+    def __init__(self, interface, on_request=None, keyboards=()):
+        self.interface = interface
+        self.on_request = on_request
+        self.keyboards = keyboards  # RGB sync group
+        self.handlers = {
+            RGB_SEND: self._forward_rgb,
+            proto.IMAGE_STATUS: self._image_status,
+        }
+        self.image_statuses = queue.Queue(maxsize=16)
+        self.lock = Lock()
+        self.waiters = deque()
+        self.late_answers = 0  # answers still owed to timed out requests
+        self.stopping = threading.Event()
+        self.closed = threading.Event()
+        self.counters = {
+            "responses": 0,
+            "requests": 0,
+            "rgb": 0,
+            "misrouted": 0,
+            "timed_out": 0,
+        }
+        self.thread = threading.Thread(target=self._run, daemon=True)
 
-    try:
-        interface.write(request_report)
+    def start(self):
+        if HID_BACKEND == "hidraw":
+            # woken by epoll only when a report arrives, no reader thread
+            hidraw_loop.register(self.interface, self._dispatch, self._close)
+        else:
+            self.thread.start()
+        return self
+
+    def alive(self):
+        return not self.closed.is_set()
+
+    def stop(self):
+        """Stop reading, must be called before the interface is closed"""
+        self.stopping.set()
+        if HID_BACKEND == "hidraw":
+            hidraw_loop.unregister(self.interface)
+            self._close()
+        elif self.thread.is_alive() and self.thread is not threading.current_thread():
+            self.thread.join()
+
+    def write(self, report):
+        return self.interface.write(report)
+
+    def request(self, reports, timeout=RESPONSE_TIMEOUT):
+        """
+        Write every report of a message and wait for the macropad's answer.
+        Returns the answer, an empty list on timeout, or COULD_NOT_CONNECT.
+        """
+        if not self.alive():
+            return COULD_NOT_CONNECT
+
+        future = Future()
+        with self.lock:
+            # once a new request goes out, an owed answer can no longer be told
+            # apart from the new one, and a lost answer must not eat it
+            self.late_answers = 0
+            self.waiters.append(future)
 
-        response_report = interface.read(report_length, timeout_ms=1000)
+        try:
+            for report in reports:
+                if self.interface.write(report) < 0:
+                    raise IOError("write failed")
+        except Exception as e:
+            debug_print(f"Communication error: {e}")
+            self._abandon(future)
+            return COULD_NOT_CONNECT
 
-        debug_print(response_report)
+        try:
+            return future.result(timeout)
+        except FutureTimeoutError:
+            with self.lock:
+                if future in self.waiters:
+                    self.waiters.remove(future)
+                    self.late_answers += 1
+                    self.counters["timed_out"] += 1
+                    return []
+            # answered between the timeout and taking the lock
+            return future.result()
+        except Exception:
+            return COULD_NOT_CONNECT
 
-    except Exception as e:
-        debug_print(f"Communication error: {e}")
+    def stats(self):
+        with self.lock:
+            return dict(self.counters)
+
+    def _abandon(self, future):
+        with self.lock:
+            if future in self.waiters:
+                self.waiters.remove(future)
+
+    def _forward_rgb(self, report):
+        debug_print(f"Received RGB layer interrupt: {report[1]}")
+        self.counters["rgb"] += 1
+        send_raw_hid_to_keyboards(self.keyboards, report[1], bytes(report[proto.RGB_TAG]))
+
+    def _image_status(self, report):
+        # nobody reads these unless an upload is running, so once the queue is
+        # full the oldest status makes way for the new one
+        if self.image_statuses.full():
+            try:
+                self.image_statuses.get_nowait()
+            except queue.Empty:
+                pass  # an uploader took it first
+        self.image_statuses.put_nowait(report)
+
+    def _dispatch(self, report):
+        handler = self.handlers.get(report[0])
+        if handler:
+            handler(report)
+            return
+
+        with self.lock:
+            if self.late_answers:
+                self.late_answers -= 1
+                self.counters["misrouted"] += 1
+                debug_print(f"Dropped late answer: {report[:4]}")
+                return
+
+            waiter = self.waiters.popleft() if self.waiters else None
+            if waiter:
+                self.counters["responses"] += 1
+            elif self.on_request:
+                self.counters["requests"] += 1
+            else:
+                self.counters["misrouted"] += 1
+
+        if waiter:
+            waiter.set_result(report)
+        elif self.on_request:
+            self.on_request(report)
+        else:
+            debug_print(f"Dropped unexpected report: {report[:4]}")
+
+    def _run(self):
+        try:
+            while not self.stopping.is_set():
+                report = self.interface.read(report_length, timeout_ms=100)
+                if report:
+                    self._dispatch(report)
+        except Exception as e:
+            # Handle cases where the device might get disconnected
+            debug_print(f"Read error: {e}")
+        finally:
+            self._close()
+
+    def _close(self):
+        self.closed.set()
+        with self.lock:
+            waiters, self.waiters = list(self.waiters), deque()
+        for waiter in waiters:
+            waiter.set_exception(IOError("macropad disconnected"))
+
+
+def send_report_with_timeout(reactor, request_reports):
+    """Write every report of a message, then wait for the macropad's answer"""
+    if reactor is None:
+        debug_print("No device found")
         return COULD_NOT_CONNECT
 
+    debug_print("Request:")
+    for request_report in request_reports:
+        debug_print(proto.decode_report(request_report[1:]) or request_report)
+
+    response_report = reactor.request(request_reports)
+
+    debug_print(response_report)
+
     return response_report
 
 
-def send_raw_hid_to_keyboard(data_to_send):
+def send_raw_hid_to_keyboards(keyboards, data_to_send, tag=b""):
     """
-    Send data to keyboard using the persistent keyboard manager
+    Hand data to every keyboard manager of a sync group, returns at once.
+    Only the newest value is written if a keyboard falls behind.
     """
-    success = keyboard_manager.send_layer_data(data_to_send)
-    if not success:
-        debug_print(f"Failed to send layer '{data_to_send}' to keyboard")
-        pass
+    for keyboard_manager in keyboards:
+        keyboard_manager.post(data_to_send, tag)
 
 
 def zero_pad(integer):
@@ -498,7 +872,21 @@ def zero_pad(integer):
 psutil.cpu_percent(interval=None)
 
 
-def get_pc_stats():
+def tlv_writer(capacity=proto.SINGLE_REPORT_BODY):
+    return proto.TlvWriter(capacity)
+
+
+def message_reports(message, link):
+    """Frame a provider message as the padded reports to write"""
+    if not link.tlv:
+        return [get_report(message)]
+
+    flags = proto.HID_FLAG_EVENT_MODE if link.event_driven else 0
+    link.message_seq = (link.message_seq + 1) & 0xFF
+    return [get_report(r) for r in proto.encode_message(message, flags, link.message_seq)]
+
+
+def read_pc_stats():
     ram_percent = round(psutil.virtual_memory().percent)
     cpu_percent = round(psutil.cpu_percent(interval=None))
 
@@ -507,14 +895,94 @@ def get_pc_stats():
     if battery is not None:
         bat_percent = battery.percent
 
+    return ram_percent, cpu_percent, bat_percent
+
+
+class ProviderSampler:
+    """
+    Reads each data source at most once per half sample interval and shares
+    the reading with every macropad, so adding a device adds no sampling
+    cost. Requests that change a source invalidate its reading.
+    """
+
+    def __init__(self, sources, intervals):
+        self.sources = sources
+        self.intervals = intervals
+        self.locks = {provider: Lock() for provider in sources}
+        self.readings = {}
+        self.reads = {provider: 0 for provider in sources}
+
+    def get(self, provider):
+        with self.locks[provider]:
+            reading = self.readings.get(provider)
+            now = time.time()
+            if reading is None or now - reading[0] >= self.intervals[provider] / 2:
+                reading = (now, self.sources[provider]())
+                self.readings[provider] = reading
+                self.reads[provider] += 1
+            return reading[1]
+
+    def invalidate(self, provider):
+        with self.locks[provider]:
+            self.readings.pop(provider, None)
+
+
+def pc_stats_fields():
+    return proto.pc_fields(*sampler.get(proto.PROVIDER_PC))
+
+
+def network_fields():
+    status, elapsed, result = sampler.get(proto.PROVIDER_NETWORK)
+
+    if status == "testing":
+        return proto.network_fields(proto.NETWORK_TESTING, elapsed_s=elapsed)
+    elif status == "completed" and result:
+        download, upload = result
+        return proto.network_fields(proto.NETWORK_COMPLETED, 0, download, upload)
+    else:
+        return proto.network_fields(proto.NETWORK_IDLE)
+
+
+def timer_fields():
+    status, remaining = sampler.get(proto.PROVIDER_TIMER)
+    return proto.timer_fields(proto.TIMER_STATES[status], remaining)
+
+
+def get_pc_stats(link):
+    if link.tlv:
+        writer = tlv_writer()
+        writer.add(
+            proto.TLV_PC_STATS,
+            proto.encode_fields(proto.PROVIDER_PC, pc_stats_fields()),
+        )
+        return writer.getvalue()
+
+    ram_percent, cpu_percent, bat_percent = sampler.get(proto.PROVIDER_PC)
+
     message = f"{PC_PERFORMANCE}{zero_pad(ram_percent)}|{zero_pad(cpu_percent)}|{zero_pad(bat_percent)}"
 
     return message.encode("utf-8")
 
 
-def get_song_info():
+def get_song_info(link):
     """Get current song information formatted for QMK"""
-    song_info = spotify_manager.get_current_song()
+    song_info = sampler.get(proto.PROVIDER_SONG)
+
+    if link.tlv:
+        writer = tlv_writer(proto.MAX_MESSAGE_BODY)
+        if song_info:
+            song_name, artists = song_info
+            writer.add(
+                proto.TLV_SONG_TITLE,
+                proto.encode_text(song_name, proto.SONG_TEXT_MAX),
+            )
+            writer.add(
+                proto.TLV_SONG_ARTIST,
+                proto.encode_text(artists, proto.SONG_TEXT_MAX),
+            )
+        else:
+            writer.add(proto.TLV_SONG_TITLE, b"")
+        return writer.getvalue()
 
     if song_info:
         song_name, artists = song_info
@@ -528,9 +996,17 @@ def get_song_info():
     return message.encode("utf-8")
 
 
-def get_network_status():
+def get_network_status(link):
     """Get current network test status and format for QMK"""
-    status, elapsed, result = speed_tester.get_status()
+    if link.tlv:
+        writer = tlv_writer()
+        writer.add(
+            proto.TLV_NETWORK,
+            proto.encode_fields(proto.PROVIDER_NETWORK, network_fields()),
+        )
+        return writer.getvalue()
+
+    status, elapsed, result = sampler.get(proto.PROVIDER_NETWORK)
 
     if status == "testing":
         elapsed_str = f"{int(elapsed)}s"
@@ -544,122 +1020,504 @@ def get_network_status():
     return message.encode("utf-8")
 
 
-def get_timer_status():
+def get_timer_status(link):
     """Get current timer status and format for QMK"""
-    status, time_remaining = pomodoro_timer.get_status()
-    message = f"{TIMER_STATUS}{status}|{time_remaining}"
+    if link.tlv:
+        writer = tlv_writer()
+        writer.add(
+            proto.TLV_TIMER,
+            proto.encode_fields(proto.PROVIDER_TIMER, timer_fields()),
+        )
+        return writer.getvalue()
+
+    status, remaining = sampler.get(proto.PROVIDER_TIMER)
+    message = f"{TIMER_STATUS}{status}|{PomodoroTimer.format_remaining(remaining)}"
     return message.encode("utf-8")
 
 
-def interpret_response(request_report):
-    if not request_report or len(request_report) == 0:
-        return get_report(get_pc_stats())
-
-    request_type = request_report[0]
-
-    if request_type == PC_PERFORMANCE:
-        return get_report(get_pc_stats())
-    elif request_type == NETWORK_SPEED:
+PROVIDER_GETTERS = {
+    proto.PROVIDER_PC: get_pc_stats,
+    proto.PROVIDER_NETWORK: get_network_status,
+    proto.PROVIDER_SONG: get_song_info,
+    proto.PROVIDER_TIMER: get_timer_status,
+}
+
+# where each provider's data comes from, read through the shared sampler
+PROVIDER_SOURCES = {
+    proto.PROVIDER_PC: read_pc_stats,
+    proto.PROVIDER_NETWORK: speed_tester.get_status,
+    proto.PROVIDER_SONG: spotify_manager.get_current_song,
+    proto.PROVIDER_TIMER: pomodoro_timer.get_state,
+}
+
+# providers with fixed-width fields that can be delta encoded
+FIELD_GETTERS = {
+    proto.PROVIDER_PC: pc_stats_fields,
+    proto.PROVIDER_NETWORK: network_fields,
+    proto.PROVIDER_TIMER: timer_fields,
+}
+
+
+def perform_request(request_type):
+    """Run the side effects of a macropad request and return the provider it wants"""
+    provider = _perform_request(request_type)
+    if request_type != KEYFRAME_REQ:
+        # commands change the source, and a request always wants fresh data
+        sampler.invalidate(provider)
+    return provider
+
+
+def _perform_request(request_type):
+    if request_type == NETWORK_SPEED:
         status, _, _ = speed_tester.get_status()
 
         if status == "idle":
             speed_tester.start_test()
 
-        return get_report(get_network_status())
+        return proto.PROVIDER_NETWORK
     elif request_type == RESET_NETWORK_TEST:
         speed_tester.reset_test()
         speed_tester.start_test()
-        return get_report(get_network_status())
+        return proto.PROVIDER_NETWORK
     elif request_type == CURRENT_SONG:
-        return get_report(get_song_info())
+        return proto.PROVIDER_SONG
     elif request_type == TIMER_STATUS:
-        return get_report(get_timer_status())
+        return proto.PROVIDER_TIMER
     elif request_type == TIMER_PAUSE_REQ:
         pomodoro_timer.toggle_pause()
-        return get_report(get_timer_status())
+        return proto.PROVIDER_TIMER
     elif request_type == TIMER_RESTART_REQ:
         pomodoro_timer.start()
-        return get_report(get_timer_status())
+        return proto.PROVIDER_TIMER
     elif request_type == TIMER_RESET_REQ:
         pomodoro_timer.reset()
-        return get_report(get_timer_status())
+        return proto.PROVIDER_TIMER
     else:
-        # Unknown request, default to PC stats
-        return get_report(get_pc_stats())
+        # PC_PERFORMANCE and unknown requests default to PC stats
+        return proto.PROVIDER_PC
 
 
-def hid_read_thread(interface):
-    while True:
+class ProviderPublisher:
+    """
+    Tracks what the macropad last received from each provider and decides what
+    to send next. In event mode it pushes changed providers, in polling mode it
+    answers requests. Either way, changed data from other providers rides along
+    in the spare space of reports that are being sent anyway.
+    """
+
+    # seconds between samples of a provider
+    SAMPLE_INTERVALS = {
+        proto.PROVIDER_PC: 1.0,
+        proto.PROVIDER_NETWORK: 1.0,
+        proto.PROVIDER_SONG: 1.0,
+        proto.PROVIDER_TIMER: 0.25,
+    }
+
+    # cheap local providers that may fill spare report space when not on screen
+    FILLER_PROVIDERS = (
+        proto.PROVIDER_TIMER,
+        proto.PROVIDER_PC,
+        proto.PROVIDER_NETWORK,
+    )
+
+    def __init__(self, link):
+        self.link = link
+        self.lock = Lock()
+        self.wake = threading.Event()
+        album_art.listeners.append(self.wake.set)
+        self.reset()
+
+    def reset(self):
+        """Forget what the macropad has seen, called on every (re)connect"""
+        with self.lock:
+            self.subscribed = 0
+            self.forced = 0
+            self.sync_pending = self.link.event_driven
+            self.last_sample = {}
+            self.last_sent = {}
+            self.last_fields = {}
+            self.generation = {}
+            self.last_keyframe = {}
+            self.last_timer_status = None
+            self.art_sent = None
+            self.unsent = []
+        self.wake.set()
+
+    def request_keyframe(self):
+        """The macropad missed a delta, resend every delta provider in full"""
+        with self.lock:
+            self.last_fields = {}
+            for provider in FIELD_GETTERS:
+                self.forced |= provider
+        self.wake.set()
+
+    def subscribe(self, providers):
+        debug_print(f"Macropad subscribed to providers {providers:#04x}")
+        with self.lock:
+            self.subscribed = providers
+            self.forced |= providers
+
+        if providers & proto.PROVIDER_NETWORK:
+            perform_request(NETWORK_SPEED)  # first visit starts a test, as polling did
+
+        self.wake.set()
+
+    def refresh(self, provider):
+        """Send provider on the next tick even if it looks unchanged"""
+        with self.lock:
+            self.forced |= provider
+        self.wake.set()
+
+    def handle_request(self, report):
+        request_type = report[0]
+        if request_type == SUBSCRIBE:
+            self.subscribe(report[1])
+        elif request_type == KEYFRAME_REQ:
+            self.request_keyframe()
+        elif request_type != 0:
+            self.refresh(perform_request(request_type))
+
+    def wait(self):
+        self.wake.wait(PUSH_TICK)
+        self.wake.clear()
+
+    def _build(self, provider, now, forced):
+        """
+        Sample a provider and build the message that brings the macropad up to
+        date. Returns (message, commit), or None when the macropad already has
+        this data and forced is not set. commit() must be called once the
+        message is actually sent.
+        """
+        self.last_sample[provider] = now
+        timer_status = None
+        if provider == proto.PROVIDER_TIMER:
+            timer_status, _ = sampler.get(proto.PROVIDER_TIMER)
+
+        if self.link.delta and provider in FIELD_GETTERS:
+            fields = FIELD_GETTERS[provider]()
+            last = self.last_fields.get(provider)
+            keyframe_due = now - self.last_keyframe.get(provider, 0) >= KEYFRAME_INTERVAL
+
+            if last is None or keyframe_due:
+                mask = proto.full_mask(provider)
+            else:
+                mask = proto.changed_mask(last, fields)
+                if not mask and not forced:
+                    return None
+                # a forced provider is always answered, unchanged data as an
+                # empty delta that still moves the generation on
+
+            generation = (self.generation.get(provider, -1) + 1) & 0xFF
+            writer = tlv_writer()
+            writer.add(
+                proto.TLV_DELTA,
+                proto.encode_delta(provider, generation, mask, fields),
+            )
+
+            def commit():
+                self.last_fields[provider] = fields
+                self.generation[provider] = generation
+                if mask == proto.full_mask(provider):
+                    self.last_keyframe[provider] = now
+                if timer_status:
+                    self.last_timer_status = timer_status
+
+            return writer.getvalue(), commit
+
+        message = PROVIDER_GETTERS[provider](self.link)
+        if not forced and message == self.last_sent.get(provider):
+            return None
+
+        def commit():
+            self.last_sent[provider] = message
+            if timer_status:
+                self.last_timer_status = timer_status
+
+        return message, commit
+
+    def collect(self, capacity=proto.SINGLE_REPORT_BODY):
+        """
+        Message bodies to write now. Required providers are packed together up
+        to capacity, then the spare space is filled greedily with any other
+        changed provider as long as that doesn't add a report. Call sent() once
+        they are written, until then the delta state still describes what the
+        macropad had before.
+        """
+        now = time.time()
+        with self.lock:
+            subscribed, forced, sync = self.subscribed, self.forced, self.sync_pending
+            self.forced = 0
+            self.sync_pending = False
+
+        messages = []
+        commits = []
+        included = 0
+        if sync:
+            writer = tlv_writer()
+            writer.add(proto.TLV_SYNC, b"")
+            messages.append(writer.getvalue())
+
+        for provider in PROVIDER_GETTERS:
+            if not provider & self.link.providers:
+                continue
+
+            due = now - self.last_sample.get(provider, 0) >= self.SAMPLE_INTERVALS[provider]
+
+            if provider & forced:
+                pass
+            elif provider & subscribed and due:
+                pass
+            elif provider == proto.PROVIDER_TIMER and due:
+                # timer completion blinks on every layer, so push state changes
+                # even when the pomodoro layer isn't shown
+                status, _ = sampler.get(proto.PROVIDER_TIMER)
+                if status == self.last_timer_status:
+                    self.last_sample[provider] = now
+                    continue
+            else:
+                continue
+
+            included |= provider
+            built = self._build(provider, now, provider & forced)
+            if built is None:
+                continue
+
+            message, commit = built
+            commits.append(commit)
+            messages.append(message)
+
+        packed = proto.pack_bodies(messages, capacity)
+
+        for provider in self.FILLER_PROVIDERS:
+            # never wake the bus just for filler
+            if not packed:
+                break
+            if provider & included or not provider & self.link.providers:
+                continue
+            if now - self.last_sample.get(provider, 0) < self.SAMPLE_INTERVALS[provider]:
+                continue
+
+            built = self._build(provider, now, False)
+            if built is None:
+                continue
+
+            message, commit = built
+            if proto.fill_spare(packed, message):
+                commits.append(commit)
+
+        # anything collected earlier and never written is forgotten
+        self.unsent = commits
+        return packed
+
+    def sent(self):
+        """The bodies from the last collect() were written, commit their state"""
+        commits, self.unsent = self.unsent, []
+        for commit in commits:
+            commit()
+
+    def push_changes(self, reactor):
+        """Write every provider whose data changed, returns False when the write fails"""
+        reports = [report for body in self.collect() for report in message_reports(body, self.link)]
+        if not write_reports(reactor, reports):
+            return False
+        self.sent()
+        return True
+
+    def push_album_art(self, reactor):
+        """Upload the cover art once the worker has it for a new track"""
+        if not self.link.album_art:
+            return True
+
+        track_id, data = album_art.current
+        if track_id == self.art_sent:
+            return True
+        self.art_sent = track_id
+
+        slot = proto.IMAGE_SLOT_ALBUM_ART
+        if data:
+            reports = proto.encode_image_upload(slot, data)
+        else:
+            reports = [proto.encode_image_erase(slot)]
+        return write_reports(reactor, [get_report(report) for report in reports])
+
+
+def write_reports(reactor, reports):
+    """Returns False when a write fails"""
+    for report in reports:
         try:
-            report = interface.read(report_length, timeout_ms=100)
-            if report:
-                if report[0] == RGB_SEND:
-                    layer = report[1]
-                    debug_print(f"Received RGB layer interrupt: {layer}")
-                    send_raw_hid_to_keyboard(layer)
-        except Exception:
-            # Handle cases where the device might get disconnected
+            if reactor.write(report) < 0:
+                return False
+        except Exception as e:
+            debug_print(f"Communication error: {e}")
+            return False
+    return True
+
+
+sampler = ProviderSampler(PROVIDER_SOURCES, ProviderPublisher.SAMPLE_INTERVALS)
+
+
+def interpret_response(request_report, publisher):
+    link = publisher.link
+
+    if not request_report or len(request_report) == 0:
+        return message_reports(get_pc_stats(link), link)
+
+    if request_report[0] == KEYFRAME_REQ:
+        publisher.request_keyframe()
+    provider = perform_request(request_report[0])
+
+    if not link.tlv:
+        return message_reports(PROVIDER_GETTERS[provider](link), link)
+
+    # the firmware answers every complete message, so everything goes into one
+    # (possibly fragmented) message to keep the request/response pairing
+    publisher.refresh(provider)
+    bodies = publisher.collect(capacity=proto.MAX_MESSAGE_BODY)
+    # the macropad only sends its next request in answer to a message, so
+    # there is always one, an empty message if the firmware can't show provider
+    if not bodies:
+        bodies = [b""]
+    return [report for body in bodies for report in message_reports(body, link)]
+
+
+def run_polling_mode(reactor, publisher):
+    """Request/response loop, returns when the connection is lost"""
+    publisher.reset()
+    reactor.on_request = None
+
+    request_reports = message_reports(get_pc_stats(publisher.link), publisher.link)
+
+    while True:
+        if not publisher.push_album_art(reactor):
+            return
+
+        response_report = send_report_with_timeout(reactor, request_reports)
+
+        if response_report == COULD_NOT_CONNECT:
+            return
+        publisher.sent()
+
+        request_reports = interpret_response(response_report, publisher)
+        time.sleep(SERVICE_INTERVAL)
+
+
+def run_event_mode(reactor, publisher):
+    """Push loop, returns when the connection is lost"""
+    publisher.reset()
+    reactor.on_request = publisher.handle_request
+
+    while reactor.alive():
+        if not publisher.push_changes(reactor) or not publisher.push_album_art(reactor):
             return
-        time.sleep(0.01)
+        publisher.wait()
 
 
-def interface_connect():
+def wait_for_hotplug(generation):
+    """Sleep until a HID device is added or removed since generation was taken"""
+    if hotplug.available:
+        hotplug.wait_for_change(generation, HOTPLUG_FALLBACK_INTERVAL)
+    else:
+        time.sleep(RECONNECT_INTERVAL)
+
+
+def interface_connect(config):
     interface = None
     while interface is None:
+        generation = hotplug.generation
         try:
-            interface = get_raw_hid_interface()
+            interface = get_raw_hid_interface(config)
             if interface is None:
-                debug_print("No device found. Retrying in 5 seconds...")
-                time.sleep(5)
+                debug_print("No device found. Waiting for it to be plugged in...")
+                wait_for_hotplug(generation)
         except Exception as e:
             debug_print(f"Error during connection attempt: {e}")
-            time.sleep(5)
+            wait_for_hotplug(generation)
     return interface
 
 
-def main():
-    interface = interface_connect()
+def handshake(reactor):
+    """
+    Open the connection with a hello and return the macropad's FirmwareInfo,
+    or None when it runs firmware from before the binary protocol
+    """
+    if PROTOCOL_MODE == "legacy":
+        return None
 
-    read_thread = threading.Thread(
-        target=hid_read_thread, args=(interface,), daemon=True
-    )
-    read_thread.start()
+    capabilities = proto.CAP_TLV | proto.CAP_FRAGMENTS
+    if EVENT_DRIVEN:
+        capabilities |= proto.CAP_EVENT_MODE
+    if DELTA_MODE:
+        capabilities |= proto.CAP_DELTA
 
-    request_report = get_report(get_pc_stats())
+    writer = tlv_writer()
+    writer.add(proto.TLV_HELLO, proto.encode_hello(capabilities))
+    hello_report = get_report(proto.encode_message(writer.getvalue())[0])
 
-    try:
-        while True:
-            try:
-                response_report = send_report_with_timeout(interface, request_report)
+    reply = reactor.request([hello_report], timeout=HELLO_TIMEOUT)
+    if reply and reply != COULD_NOT_CONNECT and reply[0] == proto.HELLO:
+        return proto.FirmwareInfo(reply)
 
-                if response_report == COULD_NOT_CONNECT:
-                    debug_print("Lost connection. Attempting to reconnect...")
-                    interface.close()
-                    interface = interface_connect()
+    # old firmware answers anything with its next request
+    return None
 
-                    if not read_thread.is_alive():
-                        read_thread = threading.Thread(
-                            target=hid_read_thread, args=(interface,), daemon=True
-                        )
-                        read_thread.start()
 
-                    request_report = get_report(get_pc_stats())
-                    continue
+def serve_macropad(config, sessions):
+    """Keep one macropad connected and served, runs on its own thread"""
+    keyboards = rgb_groups.get(config.get("group"), []) if config.get("group") else []
+    link = LinkState()
+    publisher = ProviderPublisher(link)
 
-                request_report = interpret_response(response_report)
-                time.sleep(SERVICE_INTERVAL)
+    while True:
+        interface = None
+        reactor = None
+        try:
+            interface = interface_connect(config)
+            reactor = HidReactor(interface, keyboards=keyboards).start()
+            sessions[id(config)] = (reactor, interface)
 
-            except KeyboardInterrupt:
-                debug_print("\nShutting down...")
-                break
-            except Exception as e:
-                debug_print(f"Error in main loop: {e}")
-                time.sleep(5)
+            link.configure(handshake(reactor))
+
+            if link.event_driven:
+                run_event_mode(reactor, publisher)
+            else:
+                run_polling_mode(reactor, publisher)
+
+            debug_print(
+                f"Lost connection {reactor.stats()}, sampler reads {sampler.reads}. "
+                "Attempting to reconnect..."
+            )
+
+        except Exception as e:
+            debug_print(f"Error in main loop: {e}")
+            time.sleep(5)
+
+        finally:
+            sessions.pop(id(config), None)
+            if reactor:
+                reactor.stop()
+            if interface:
+                interface.close()
+
+
+def main():
+    sessions = {}  # macropads currently connected, closed on shutdown
+
+    for config in MACROPADS:
+        threading.Thread(target=serve_macropad, args=(config, sessions), daemon=True).start()
+
+    try:
+        while True:
+            time.sleep(1)
+
+    except KeyboardInterrupt:
+        debug_print("\nShutting down...")
 
     finally:
         debug_print("Cleaning up connections...")
-        keyboard_manager.cleanup()
-        if interface:
+        for keyboard_manager in keyboard_managers:
+            keyboard_manager.cleanup()
+        for reactor, interface in list(sessions.values()):
+            reactor.stop()
             interface.close()
         debug_print("Cleanup complete.")
 
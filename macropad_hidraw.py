@@ -0,0 +1,405 @@
+"""
+Optional Linux backend that talks to /dev/hidrawN directly instead of going
+through hidapi's timed reads.
+
+Every open macropad and keyboard fd is registered with one HidrawLoop, which
+waits on all of them with epoll (through selectors) and only wakes when a
+report arrives or a device goes away.
+
+UhidDevice creates a virtual raw HID device through /dev/uhid so the backend
+can be exercised without hardware, see selftest() at the bottom.
+"""
+
+import os
+import select
+import selectors
+import struct
+import threading
+import time
+from collections import deque
+
+SYSFS_HIDRAW = "/sys/class/hidraw"
+
+# hidraw returns one report per read, this is larger than any raw HID report
+READ_SIZE = 64
+
+# register/unregister calls from other threads wait this long for the loop
+CALL_TIMEOUT = 1.0
+
+
+def _read_sysfs(path, mode="r"):
+    try:
+        with open(path, mode) as file:
+            return file.read()
+    except OSError:
+        return None
+
+
+def parse_hid_id(uevent):
+    """(bus, vendor_id, product_id) from the HID_ID line of a hid device uevent"""
+    for line in uevent.splitlines():
+        if line.startswith("HID_ID="):
+            bus, vendor_id, product_id = line[len("HID_ID=") :].split(":")
+            return int(bus, 16), int(vendor_id, 16), int(product_id, 16)
+    return None
+
+
+def descriptor_usage(descriptor):
+    """Usage page and usage of the first top-level collection in a report descriptor"""
+    usage_page = usage = None
+    pos = 0
+    while pos < len(descriptor):
+        prefix = descriptor[pos]
+        if prefix == 0xFE:  # long item, never carries a usage
+            pos += 3 + descriptor[pos + 1]
+            continue
+
+        size = (0, 1, 2, 4)[prefix & 0x03]
+        value = int.from_bytes(descriptor[pos + 1 : pos + 1 + size], "little")
+        tag = prefix & 0xFC
+
+        if tag == 0x04 and usage_page is None:  # global Usage Page
+            usage_page = value
+        elif tag == 0x08 and usage is None:  # local Usage
+            usage = value
+        elif tag == 0xA0:  # Collection, its usage is known by now
+            break
+
+        pos += 1 + size
+
+    return usage_page, usage
+
+
+def find_devices(vendor_id, product_id, usage_page, usage, sysfs=SYSFS_HIDRAW):
+    """/dev/hidrawN paths of every interface matching the ids and usage"""
+    try:
+        nodes = sorted(os.listdir(sysfs), key=lambda n: int(n[len("hidraw") :] or 0))
+    except OSError:
+        return []
+
+    paths = []
+    for node in nodes:
+        device_dir = os.path.join(sysfs, node, "device")
+
+        hid_id = parse_hid_id(_read_sysfs(os.path.join(device_dir, "uevent")) or "")
+        if hid_id is None or hid_id[1:] != (vendor_id, product_id):
+            continue
+
+        descriptor = _read_sysfs(os.path.join(device_dir, "report_descriptor"), "rb")
+        if descriptor is None or descriptor_usage(descriptor) != (usage_page, usage):
+            continue
+
+        paths.append(os.path.join("/dev", node))
+
+    return paths
+
+
+class HidrawDevice:
+    """An open /dev/hidrawN with the subset of the hid.device API the client uses"""
+
+    def __init__(self, path):
+        self.path = path
+        self.fd = os.open(path, os.O_RDWR | os.O_NONBLOCK | os.O_CLOEXEC)
+
+    def fileno(self):
+        return self.fd
+
+    def set_nonblocking(self, enabled):
+        # always non-blocking, waiting is done by select or the loop
+        pass
+
+    def write(self, data):
+        # like hidapi, the first byte is the report number (0 for raw HID)
+        return os.write(self.fd, bytes(data))
+
+    def read_now(self, length=READ_SIZE):
+        """One pending report, or [] when none is queued. Raises OSError once unplugged."""
+        try:
+            return list(os.read(self.fd, length))
+        except BlockingIOError:
+            return []
+
+    def read(self, length, timeout_ms=0):
+        if timeout_ms:
+            select.select([self.fd], [], [], timeout_ms / 1000)
+        return self.read_now(length)
+
+    def close(self):
+        if self.fd is not None:
+            try:
+                os.close(self.fd)
+            except OSError:
+                pass
+            self.fd = None
+
+
+class HidrawLoop:
+    """
+    One thread waiting on every registered device. on_report(report) is called
+    for each report read, on_close() once when the device stops responding;
+    both run on the loop thread, so they should hand slow work off.
+    """
+
+    def __init__(self):
+        self.selector = selectors.DefaultSelector()
+        self.lock = threading.Lock()
+        self.calls = deque()
+        self.thread = None
+        self.wakeups = 0
+
+        self.wake_read, self.wake_write = os.pipe()
+        os.set_blocking(self.wake_read, False)
+        self.selector.register(self.wake_read, selectors.EVENT_READ, None)
+
+    def start(self):
+        with self.lock:
+            if self.thread is None or not self.thread.is_alive():
+                self.thread = threading.Thread(target=self._run, daemon=True)
+                self.thread.start()
+
+    def register(self, device, on_report, on_close):
+        self.start()
+        self._call(lambda: self._watch(device.fileno(), (device, on_report, on_close)))
+
+    def unregister(self, device):
+        """Stop watching device, safe to close it once this returns"""
+        fd = device.fileno()
+        if fd is None:
+            return
+        if not self._call(lambda: self._forget(fd, device)):
+            # the loop thread is stuck, don't leave a closed fd in the selector
+            # for the next device that gets the same number
+            self._forget(fd, device)
+
+    def _watch(self, fd, data):
+        try:
+            self.selector.register(fd, selectors.EVENT_READ, data)
+        except KeyError:
+            # an fd number reused after a device was closed without
+            # unregistering, the kernel already dropped the old one from epoll
+            try:
+                self.selector.unregister(fd)
+            except OSError:
+                pass
+            self.selector.register(fd, selectors.EVENT_READ, data)
+
+    def _forget(self, fd, device):
+        """Stop watching fd, unless it has been reused by another device"""
+        try:
+            if self.selector.get_key(fd).data[0] is device:
+                self.selector.unregister(fd)
+        except (KeyError, ValueError):
+            pass
+
+    def _call(self, function):
+        """
+        Run function on the loop thread, which owns the selector. Returns False
+        if it didn't run within CALL_TIMEOUT, it may still run later.
+        """
+        if threading.current_thread() is self.thread:
+            function()
+            return True
+
+        done = threading.Event()
+
+        def call():
+            try:
+                function()
+            finally:
+                done.set()
+
+        with self.lock:
+            self.calls.append(call)
+        os.write(self.wake_write, b"\0")
+        return done.wait(CALL_TIMEOUT)
+
+    def _run_calls(self):
+        try:
+            while os.read(self.wake_read, 64):
+                pass
+        except BlockingIOError:
+            pass
+
+        with self.lock:
+            calls, self.calls = list(self.calls), deque()
+        for call in calls:
+            call()
+
+    def _run(self):
+        while True:
+            events = self.selector.select()
+            self.wakeups += 1
+
+            for key, _ in events:
+                if key.data is None:
+                    self._run_calls()
+                    continue
+
+                device, on_report, on_close = key.data
+                try:
+                    report = device.read_now()
+                except OSError:
+                    self._forget(key.fd, device)
+                    on_close()
+                    continue
+
+                if report:
+                    try:
+                        on_report(report)
+                    except Exception:
+                        pass
+
+
+# -------------------------------------------------------------------------- #
+# Virtual devices through /dev/uhid
+# -------------------------------------------------------------------------- #
+
+UHID_DESTROY = 1
+UHID_OUTPUT = 6
+UHID_CREATE2 = 11
+UHID_INPUT2 = 12
+
+UHID_DATA_MAX = 4096
+UHID_EVENT_SIZE = 4376  # sizeof(struct uhid_event), the create2 request is the largest
+UHID_OUTPUT_SIZE_OFFSET = 4 + UHID_DATA_MAX
+
+BUS_USB = 0x03
+
+# the descriptor QMK uses for its raw HID interface, 32 byte in and out reports
+# fmt: off
+RAW_HID_DESCRIPTOR = bytes(
+    [
+        0x06, 0x60, 0xFF,  # Usage Page (0xFF60)
+        0x09, 0x61,  # Usage (0x61)
+        0xA1, 0x01,  # Collection (Application)
+        0x09, 0x62,  # Usage (0x62)
+        0x15, 0x00,  # Logical Minimum (0)
+        0x26, 0xFF, 0x00,  # Logical Maximum (255)
+        0x95, 0x20,  # Report Count (32)
+        0x75, 0x08,  # Report Size (8)
+        0x81, 0x02,  # Input (Data, Variable, Absolute)
+        0x09, 0x63,  # Usage (0x63)
+        0x15, 0x00,  # Logical Minimum (0)
+        0x26, 0xFF, 0x00,  # Logical Maximum (255)
+        0x95, 0x20,  # Report Count (32)
+        0x75, 0x08,  # Report Size (8)
+        0x91, 0x02,  # Output (Data, Variable, Absolute)
+        0xC0,  # End Collection
+    ]
+)
+# fmt: on
+
+
+class UhidDevice:
+    """A virtual raw HID device, plays the firmware side of a hidraw node"""
+
+    def __init__(self, name, vendor_id, product_id, descriptor=RAW_HID_DESCRIPTOR):
+        self.fd = os.open("/dev/uhid", os.O_RDWR | os.O_CLOEXEC)
+        self._write_event(
+            struct.pack(
+                "<I128s64s64sHHIIII",
+                UHID_CREATE2,
+                name.encode("utf-8"),
+                b"",
+                b"",
+                len(descriptor),
+                BUS_USB,
+                vendor_id,
+                product_id,
+                0,
+                0,
+            )
+            + descriptor
+        )
+
+    def fileno(self):
+        return self.fd
+
+    def _write_event(self, event):
+        os.write(self.fd, event.ljust(UHID_EVENT_SIZE, b"\0"))
+
+    def send_input(self, report):
+        """Deliver a report to whoever has the hidraw node open"""
+        self._write_event(struct.pack("<IH", UHID_INPUT2, len(report)) + bytes(report))
+
+    def read_output(self, timeout=None):
+        """Next report the host wrote, without its report number, or None on timeout"""
+        deadline = None if timeout is None else time.time() + timeout
+        while True:
+            remaining = None if deadline is None else max(0, deadline - time.time())
+            if not select.select([self.fd], [], [], remaining)[0]:
+                return None
+
+            event = os.read(self.fd, UHID_EVENT_SIZE)
+            if struct.unpack_from("<I", event)[0] != UHID_OUTPUT:
+                continue  # start/open/close notifications
+
+            size = struct.unpack_from("<H", event, UHID_OUTPUT_SIZE_OFFSET)[0]
+            data = event[4 : 4 + size]
+            return data[1:] if data[:1] == b"\0" else data
+
+    def close(self):
+        try:
+            self._write_event(struct.pack("<I", UHID_DESTROY))
+        finally:
+            os.close(self.fd)
+
+
+def wait_for_device(vendor_id, product_id, usage_page, usage, timeout=2.0):
+    """Path of a freshly created device once udev has made its node"""
+    deadline = time.time() + timeout
+    while time.time() < deadline:
+        paths = find_devices(vendor_id, product_id, usage_page, usage)
+        if paths and os.path.exists(paths[-1]):
+            return paths[-1]
+        time.sleep(0.01)
+    return None
+
+
+def selftest(vendor_id=0xFEED, product_id=0x9A25, count=1000):
+    """Round trips through a uhid device and the loop, needs root or uhid access"""
+    virtual = UhidDevice("macropad selftest", vendor_id, product_id)
+    try:
+        path = wait_for_device(vendor_id, product_id, 0xFF60, 0x61)
+        if path is None:
+            raise RuntimeError("hidraw node for the uhid device never appeared")
+
+        device = HidrawDevice(path)
+        loop = HidrawLoop()
+        received = deque()
+        arrived = threading.Event()
+
+        def on_report(report):
+            received.append((time.perf_counter(), report))
+            arrived.set()
+
+        loop.register(device, on_report, arrived.set)
+
+        latencies = []
+        for i in range(count):
+            arrived.clear()
+            sent = time.perf_counter()
+            virtual.send_input(bytes([5, i & 0xFF]) + bytes(30))
+            if not arrived.wait(1.0):
+                raise RuntimeError(f"report {i} never arrived")
+            at, report = received.popleft()
+            assert report[:2] == [5, i & 0xFF], report
+            latencies.append(at - sent)
+
+        device.write(bytes([0, 1, 2, 3]) + bytes(29))
+        assert virtual.read_output(1.0)[:3] == b"\x01\x02\x03"
+
+        loop.unregister(device)
+        device.close()
+
+        latencies.sort()
+        print(
+            f"{count} reports, p50 {latencies[len(latencies) // 2] * 1e6:.0f} us, "
+            f"max {latencies[-1] * 1e6:.0f} us, {loop.wakeups} loop wakeups"
+        )
+    finally:
+        virtual.close()
+
+
+if __name__ == "__main__":
+    selftest()
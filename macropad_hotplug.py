@@ -0,0 +1,147 @@
+"""
+Hotplug notifications for HID devices from the uevent netlink socket (Linux).
+
+The client sleeps on this instead of re-enumerating every few seconds. Both
+the kernel group and the udev group are joined: the kernel event arrives
+first, and the udev event follows once rules have set the node's permissions,
+so a device that couldn't be opened on the first event is retried on the
+second. Like libudev, only messages sent by root are believed, and kernel
+group messages must come from the kernel itself. Elsewhere, or when the
+socket can't be opened or fails, available is False and callers fall back to
+timed enumeration.
+"""
+
+import errno
+import socket
+import struct
+import sys
+import threading
+
+NETLINK_KOBJECT_UEVENT = 15
+GROUP_KERNEL = 1
+GROUP_UDEV = 2
+
+UDEV_PREFIX = b"libudev\0"
+UDEV_MAGIC = 0xFEEDCAFE
+
+RECV_SIZE = 16384
+CREDENTIALS = struct.Struct("=iII")  # struct ucred: pid, uid, gid
+
+
+def parse_uevent(message):
+    """Properties of a kernel or libudev uevent message, {} if it isn't one"""
+    if message.startswith(UDEV_PREFIX):
+        if len(message) < 24 or struct.unpack_from("!I", message, 8)[0] != UDEV_MAGIC:
+            return {}
+        properties_off, properties_len = struct.unpack_from("=II", message, 16)
+        payload = message[properties_off : properties_off + properties_len]
+    elif b"@" in message.split(b"\0", 1)[0]:
+        # kernel messages start with "action@devpath"
+        payload = message.split(b"\0", 1)[1] if b"\0" in message else b""
+    else:
+        return {}
+
+    properties = {}
+    for item in payload.split(b"\0"):
+        key, sep, value = item.partition(b"=")
+        if sep:
+            properties[key.decode("utf-8", "replace")] = value.decode("utf-8", "replace")
+    return properties
+
+
+class HotplugMonitor:
+    """
+    Counts add/remove events for the given subsystems. Callers take the
+    generation before looking for a device and wait_for_change() with it, so
+    a device plugged in between the two is never missed. Listeners are called
+    on the monitor thread with (action, properties).
+    """
+
+    def __init__(self, subsystems=("hidraw",)):
+        self.subsystems = subsystems
+        self.generation = 0
+        self.condition = threading.Condition()
+        self.listeners = []
+        self.sock = self._open()
+        self.available = self.sock is not None
+
+        if self.available:
+            threading.Thread(target=self._run, daemon=True).start()
+
+    def _open(self):
+        if not sys.platform.startswith("linux"):
+            return None
+        try:
+            sock = socket.socket(
+                socket.AF_NETLINK,
+                socket.SOCK_DGRAM | socket.SOCK_CLOEXEC,
+                NETLINK_KOBJECT_UEVENT,
+            )
+            sock.setsockopt(socket.SOL_SOCKET, socket.SO_PASSCRED, 1)
+            sock.bind((0, GROUP_KERNEL | GROUP_UDEV))
+            return sock
+        except (OSError, AttributeError):
+            return None
+
+    def add_listener(self, callback):
+        self.listeners.append(callback)
+
+    def wait_for_change(self, generation, timeout=None):
+        """Block until an event newer than generation, returns False on timeout"""
+        with self.condition:
+            return self.condition.wait_for(lambda: self.generation != generation, timeout)
+
+    def _changed(self):
+        with self.condition:
+            self.generation += 1
+            self.condition.notify_all()
+
+    def _receive(self):
+        """The next message, None if it wasn't sent by root"""
+        message, ancdata, _flags, (sender_pid, groups) = self.sock.recvmsg(
+            RECV_SIZE, socket.CMSG_SPACE(CREDENTIALS.size)
+        )
+
+        uid = None
+        for level, kind, data in ancdata:
+            if level == socket.SOL_SOCKET and kind == socket.SCM_CREDENTIALS:
+                _pid, uid, _gid = CREDENTIALS.unpack_from(data)
+        if uid != 0:
+            return None
+        # udevd sends from its own port, kernel messages only from port 0
+        if groups == GROUP_KERNEL and sender_pid != 0:
+            return None
+        return message
+
+    def _run(self):
+        while True:
+            try:
+                message = self._receive()
+            except OSError as e:
+                if e.errno == errno.ENOBUFS:
+                    # events were dropped, so whatever they were must be looked for
+                    self._changed()
+                    continue
+                break
+            if message is None:
+                continue
+
+            properties = parse_uevent(message)
+            action = properties.get("ACTION")
+            if properties.get("SUBSYSTEM") not in self.subsystems:
+                continue
+            if action not in ("add", "remove"):
+                continue
+
+            self._changed()
+
+            for listener in self.listeners:
+                try:
+                    listener(action, properties)
+                except Exception:
+                    pass
+
+        # the socket is unusable, callers go back to timed enumeration
+        self.available = False
+        self.sock.close()
+        self._changed()
@@ -0,0 +1,389 @@
+"""
+Binary TLV wire format shared with hid_protocol.c in the firmware.
+
+A report is a two byte header (magic nibble + version, flags) followed by
+type/length/value records. All integers are little endian. Messages whose
+records don't fit in one report are split into fragments that carry a
+sequence number, the fragment index and the fragment count after the header.
+"""
+
+import struct
+
+REPORT_LENGTH = 32
+
+HID_PROTO_MAGIC = 0xB0
+HID_PROTO_MAGIC_MASK = 0xF0
+HID_PROTO_VERSION = 1
+HEADER_SIZE = 2
+TLV_HEADER_SIZE = 2
+
+TLV_END = 0
+TLV_PC_STATS = 1
+TLV_NETWORK = 2
+TLV_SONG_TITLE = 3
+TLV_SONG_ARTIST = 4
+TLV_TIMER = 5
+TLV_SYNC = 6
+TLV_DELTA = 7
+TLV_HELLO = 8
+
+# first byte of the firmware's answer to TLV_HELLO
+HELLO = 12
+
+CAP_TLV = 1 << 0
+CAP_EVENT_MODE = 1 << 1
+CAP_FRAGMENTS = 1 << 2
+CAP_DELTA = 1 << 3
+CAP_IMAGE_SLOTS = 1 << 4
+CAP_FRAME_STREAM = 1 << 5
+
+LAYER_KINDS = {
+    1: "home",
+    2: "programming",
+    3: "git",
+    4: "markdown",
+    5: "network",
+    6: "media",
+    7: "pomodoro",
+    8: "arrows",
+    9: "nvim",
+}
+
+# RGB_SEND reports carry the layer or colour, then a u16 sequence and the
+# macropad's u32 millisecond timer, then RGB_HSV_PRESENT and the layer's HSV
+# colour. The host passes everything after the layer byte on to the keyboard
+# untouched. Keyboard firmware built with RGB_RECEIPT_ENABLE echoes the
+# sequence and timer back in an RGB_RECEIPT report.
+RGB_SEND = 5
+RGB_TAG = slice(2, 12)
+RGB_HSV_PRESENT = 0x01
+RGB_RECEIPT = 0xEC
+
+# Arrows layer image uploads, see image_slots.h. BEGIN, COMMIT and ERASE are
+# each answered with an IMAGE_STATUS report, DATA reports are not answered.
+IMAGE_UPLOAD = 0xC1
+IMAGE_STATUS = 13
+
+IMAGE_OP_BEGIN = 1
+IMAGE_OP_DATA = 2
+IMAGE_OP_COMMIT = 3
+IMAGE_OP_ERASE = 4
+
+# kept in RAM for the media layer, see macropad_album_art.py
+IMAGE_SLOT_ALBUM_ART = 0xFF
+
+IMAGE_DATA_HEADER_SIZE = 5
+IMAGE_DATA_CHUNK = REPORT_LENGTH - IMAGE_DATA_HEADER_SIZE
+
+IMAGE_OK = 0
+IMAGE_ERR_SLOT = 1
+IMAGE_ERR_LENGTH = 2
+IMAGE_ERR_BUSY = 3
+IMAGE_ERR_SEQUENCE = 4
+IMAGE_ERR_CRC = 5
+IMAGE_ERR_VERIFY = 6
+
+IMAGE_STATUSES = {
+    IMAGE_OK: "ok",
+    IMAGE_ERR_SLOT: "no such slot",
+    IMAGE_ERR_LENGTH: "bad length",
+    IMAGE_ERR_BUSY: "busy writing the previous image",
+    IMAGE_ERR_SEQUENCE: "data out of sequence",
+    IMAGE_ERR_CRC: "crc mismatch",
+    IMAGE_ERR_VERIFY: "EEPROM verify failed",
+}
+
+# Framebuffer streaming, see frame_stream.h. Nothing is answered.
+FRAME_STREAM = 0xC2
+
+FRAME_OP_START = 1
+FRAME_OP_RAW = 2
+FRAME_OP_RLE = 3
+FRAME_OP_END = 4
+FRAME_OP_STOP = 5
+
+FRAME_DATA_HEADER_SIZE = 5
+FRAME_DATA_CHUNK = REPORT_LENGTH - FRAME_DATA_HEADER_SIZE
+
+# header flags
+HID_FLAG_EVENT_MODE = 1 << 0
+HID_FLAG_FRAGMENT = 1 << 1
+
+FRAGMENT_HEADER_SIZE = 3
+FRAGMENT_PAYLOAD = REPORT_LENGTH - HEADER_SIZE - FRAGMENT_HEADER_SIZE
+MAX_FRAGMENTS = 6
+SINGLE_REPORT_BODY = REPORT_LENGTH - HEADER_SIZE
+MAX_MESSAGE_BODY = FRAGMENT_PAYLOAD * MAX_FRAGMENTS
+
+# firmware text buffers hold 64 bytes including the terminator
+SONG_TEXT_MAX = 63
+
+# provider bits, used in SUBSCRIBE requests
+PROVIDER_PC = 1 << 0
+PROVIDER_NETWORK = 1 << 1
+PROVIDER_SONG = 1 << 2
+PROVIDER_TIMER = 1 << 3
+ALL_PROVIDERS = PROVIDER_PC | PROVIDER_NETWORK | PROVIDER_SONG | PROVIDER_TIMER
+
+# struct format of each field, in the order of the firmware field tables.
+# Song text has no fixed-width fields and is always sent in full.
+FIELD_FORMATS = {
+    PROVIDER_PC: "BBB",  # ram %, cpu %, battery %
+    PROVIDER_NETWORK: "BHHH",  # state, elapsed s, download Mbps x10, upload Mbps x10
+    PROVIDER_TIMER: "BI",  # state, remaining s
+}
+
+NETWORK_NO_DATA = 0
+NETWORK_IDLE = 1
+NETWORK_TESTING = 2
+NETWORK_COMPLETED = 3
+
+TIMER_STATE_STOPPED = 0
+TIMER_STATE_RUNNING = 1
+TIMER_STATE_PAUSED = 2
+TIMER_STATE_COMPLETED = 3
+
+TIMER_STATES = {
+    "STOPPED": TIMER_STATE_STOPPED,
+    "RUNNING": TIMER_STATE_RUNNING,
+    "PAUSED": TIMER_STATE_PAUSED,
+    "COMPLETED": TIMER_STATE_COMPLETED,
+}
+
+
+class TlvWriter:
+    """Packs records into a message body, refusing records that don't fit"""
+
+    def __init__(self, capacity=SINGLE_REPORT_BODY):
+        self.capacity = min(capacity, MAX_MESSAGE_BODY)
+        self.buffer = bytearray()
+
+    def remaining(self):
+        """Space left for the value of one more record"""
+        return max(0, self.capacity - len(self.buffer) - TLV_HEADER_SIZE)
+
+    def add(self, tlv_type, value):
+        if len(value) > self.remaining():
+            return False
+        self.buffer += bytes([tlv_type, len(value)]) + value
+        return True
+
+    def getvalue(self):
+        return bytes(self.buffer)
+
+
+def encode_message(body, flags=0, seq=0):
+    """Frame a message body as one report, or as fragments when it is too large"""
+    header = HID_PROTO_MAGIC | HID_PROTO_VERSION
+
+    if len(body) <= SINGLE_REPORT_BODY:
+        return [bytes([header, flags]) + body]
+
+    slices = [
+        body[i : i + FRAGMENT_PAYLOAD] for i in range(0, len(body), FRAGMENT_PAYLOAD)
+    ]
+    if len(slices) > MAX_FRAGMENTS:
+        raise ValueError(f"message of {len(body)} bytes exceeds {MAX_MESSAGE_BODY}")
+
+    return [
+        bytes([header, flags | HID_FLAG_FRAGMENT, seq & 0xFF, index, len(slices)]) + part
+        for index, part in enumerate(slices)
+    ]
+
+
+def pc_fields(ram, cpu, battery):
+    return (_clamp_u8(ram), _clamp_u8(cpu), _clamp_u8(battery))
+
+
+def network_fields(state, elapsed_s=0, download_mbps=0.0, upload_mbps=0.0):
+    return (
+        state,
+        min(int(elapsed_s), 0xFFFF),
+        min(int(round(download_mbps * 10)), 0xFFFF),
+        min(int(round(upload_mbps * 10)), 0xFFFF),
+    )
+
+
+def timer_fields(state, remaining_s):
+    return (state, max(0, int(remaining_s)))
+
+
+def encode_fields(provider, fields):
+    """Full record value for a provider"""
+    return struct.pack("<" + FIELD_FORMATS[provider], *fields)
+
+
+def full_mask(provider):
+    return (1 << len(FIELD_FORMATS[provider])) - 1
+
+
+def changed_mask(old_fields, new_fields):
+    return sum(1 << i for i, (a, b) in enumerate(zip(old_fields, new_fields)) if a != b)
+
+
+def encode_delta(provider, generation, mask, fields):
+    """TLV_DELTA value carrying only the fields set in mask"""
+    value = bytearray([provider.bit_length() - 1, generation & 0xFF, mask])
+    for index, (fmt, field) in enumerate(zip(FIELD_FORMATS[provider], fields)):
+        if mask & (1 << index):
+            value += struct.pack("<" + fmt, field)
+    return bytes(value)
+
+
+def encode_text(text, max_len):
+    """UTF-8 encode text, cutting it to max_len bytes without splitting a character"""
+    encoded = text.encode("utf-8")[:max_len]
+    return encoded.decode("utf-8", "ignore").encode("utf-8")
+
+
+class FirmwareInfo:
+    """What the macropad said about itself in its HELLO report"""
+
+    def __init__(self, report):
+        self.version = report[1]
+        self.capabilities = report[2] | (report[3] << 8)
+        self.report_size = report[4]
+        self.screen_lines = report[5]
+        self.screen_columns = report[6]
+        self.providers = report[7]
+        count = report[8]
+        self.layers = [LAYER_KINDS.get(kind, f"unknown {kind}") for kind in report[9 : 9 + count]]
+        self.variant = bytes(report[9 + count :]).split(b"\0")[0].decode("utf-8", "ignore")
+
+    def has(self, capability):
+        return bool(self.capabilities & capability)
+
+    def __repr__(self):
+        return (
+            f"FirmwareInfo(variant={self.variant!r}, version={self.version}, "
+            f"caps={self.capabilities:#06x}, report={self.report_size}, "
+            f"screen={self.screen_columns}x{self.screen_lines}, "
+            f"providers={self.providers:#04x}, layers={self.layers})"
+        )
+
+
+def encode_hello(capabilities):
+    return struct.pack("<BH", HID_PROTO_VERSION, capabilities)
+
+
+def encode_rgb_send(value, seq, timer_ms, hsv=None):
+    """RGB_SEND report as written by hid_protocol_write_rgb()"""
+    report = bytes([RGB_SEND, value]) + struct.pack("<HI", seq & 0xFFFF, timer_ms & 0xFFFFFFFF)
+    if hsv is not None:
+        report += bytes([RGB_HSV_PRESENT, *hsv])
+    return report.ljust(REPORT_LENGTH, b"\0")
+
+
+def decode_rgb_tag(tag):
+    """(sequence, macropad timer ms) from the start of the tag bytes"""
+    return struct.unpack("<HI", bytes(tag[:6]))
+
+
+def decode_receipt(report):
+    """(layer, sequence, macropad timer ms, keyboard timer ms) of an RGB_RECEIPT report"""
+    seq, macropad_ms = decode_rgb_tag(report[2:8])
+    keyboard_ms = struct.unpack("<I", bytes(report[8:12]))[0]
+    return report[1], seq, macropad_ms, keyboard_ms
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC-16/CCITT-FALSE, same as image_crc16() in the firmware"""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021 if crc & 0x8000 else crc << 1) & 0xFFFF
+    return crc
+
+
+def encode_image_upload(slot, data):
+    """Every report of an upload of RLE image data to a slot, BEGIN to COMMIT"""
+    reports = [bytes([IMAGE_UPLOAD, IMAGE_OP_BEGIN, slot]) + struct.pack("<HH", len(data), crc16(data))]
+    for offset in range(0, len(data), IMAGE_DATA_CHUNK):
+        chunk = data[offset : offset + IMAGE_DATA_CHUNK]
+        reports.append(bytes([IMAGE_UPLOAD, IMAGE_OP_DATA]) + struct.pack("<HB", offset, len(chunk)) + chunk)
+    reports.append(bytes([IMAGE_UPLOAD, IMAGE_OP_COMMIT]))
+    return [report.ljust(REPORT_LENGTH, b"\0") for report in reports]
+
+
+def encode_image_erase(slot):
+    return bytes([IMAGE_UPLOAD, IMAGE_OP_ERASE, slot]).ljust(REPORT_LENGTH, b"\0")
+
+
+def encode_frame_data(op, offset, data):
+    report = bytes([FRAME_STREAM, op]) + struct.pack("<HB", offset, len(data)) + data
+    return report.ljust(REPORT_LENGTH, b"\0")
+
+
+def encode_frame_op(op, *values):
+    """START, END with its u8 sequence, or STOP"""
+    return bytes([FRAME_STREAM, op, *values]).ljust(REPORT_LENGTH, b"\0")
+
+
+def decode_image_status(report):
+    """(slot, status, slot count, valid slot mask, bytes) of an IMAGE_STATUS report"""
+    slot, status, count, valid = report[1:5]
+    return slot, status, count, valid, report[5] | (report[6] << 8)
+
+
+def report_count(body):
+    """Number of reports encode_message() needs for a body"""
+    if len(body) <= SINGLE_REPORT_BODY:
+        return 1
+    return -(-len(body) // FRAGMENT_PAYLOAD)
+
+
+def pack_bodies(bodies, capacity=SINGLE_REPORT_BODY):
+    """
+    First-fit decreasing packing of message bodies into as few messages of at
+    most capacity bytes as possible. Bodies larger than capacity stay alone.
+    """
+    packed = []
+    for body in sorted(bodies, key=len, reverse=True):
+        for index, existing in enumerate(packed):
+            if len(existing) + len(body) <= capacity:
+                packed[index] = existing + body
+                break
+        else:
+            packed.append(body)
+    return packed
+
+
+def fill_spare(packed, body):
+    """Append body to a packed message if it fits without needing another report"""
+    for index, existing in enumerate(packed):
+        combined = existing + body
+        if len(combined) <= MAX_MESSAGE_BODY and report_count(combined) == report_count(existing):
+            packed[index] = combined
+            return True
+    return False
+
+
+def is_tlv_report(data):
+    return len(data) >= HEADER_SIZE and (data[0] & HID_PROTO_MAGIC_MASK) == HID_PROTO_MAGIC
+
+
+def decode_report(data):
+    """Returns the list of (type, value) records in an unfragmented report"""
+    if not is_tlv_report(data) or (data[0] & 0x0F) != HID_PROTO_VERSION:
+        return []
+    if data[1] & HID_FLAG_FRAGMENT:
+        return []
+    return decode_records(data[HEADER_SIZE:])
+
+
+def decode_records(data):
+    """Returns the list of (type, value) records in a message body, mirrors the firmware decoder"""
+    records = []
+    pos = 0
+    while pos + TLV_HEADER_SIZE <= len(data):
+        tlv_type, length = data[pos], data[pos + 1]
+        if tlv_type == TLV_END or pos + TLV_HEADER_SIZE + length > len(data):
+            break
+        start = pos + TLV_HEADER_SIZE
+        records.append((tlv_type, bytes(data[start : start + length])))
+        pos = start + length
+    return records
+
+
+def _clamp_u8(value):
+    return max(0, min(255, int(round(value))))
@@ -0,0 +1,226 @@
+"""
+Streams frames rendered on the host to the macropad's OLED.
+
+    python macropad_stream.py [--fps N] [--no-rle] [--macropad N]
+
+The macropad stops drawing its layer screens while a stream runs, and goes
+back to them when the stream stops or goes quiet (see frame_stream.h). Only
+the 8x8 tiles that changed since the previous frame are sent, and runs of
+changed tiles are RLE compressed when that needs fewer reports. Stop the
+client first so it isn't reading the macropad's reports.
+
+The demo draws a clock and a CPU graph, which needs Pillow. FrameEncoder
+works on plain page bytes and is what macropad_benchmark.py stream measures.
+"""
+
+import argparse
+import time
+
+import macropad_bitmaps as bitmaps
+import macropad_protocol as proto
+
+WIDTH = 128
+HEIGHT = 64
+FRAME_SIZE = WIDTH * HEIGHT // 8
+TILE_SIZE = 8
+TILES = FRAME_SIZE // TILE_SIZE
+
+
+def changed_spans(old, new):
+    """(start, end) byte ranges of runs of 8x8 tiles that differ"""
+    spans = []
+    for tile in range(TILES):
+        start = tile * TILE_SIZE
+        end = start + TILE_SIZE
+        if old[start:end] == new[start:end]:
+            continue
+        if spans and spans[-1][1] == start:
+            spans[-1] = (spans[-1][0], end)
+        else:
+            spans.append((start, end))
+    return spans
+
+
+def _longest_rle_prefix(data):
+    """(length, encoded) of the longest prefix of data whose RLE fits one report"""
+    low, high = 0, len(data)
+    best = (0, b"")
+    while low < high:
+        mid = (low + high + 1) // 2
+        encoded = bitmaps.encode(data[:mid])
+        if len(encoded) <= proto.FRAME_DATA_CHUNK:
+            best = (mid, encoded)
+            low = mid
+        else:
+            high = mid - 1
+    return best
+
+
+def encode_span(frame, start, end, rle=True):
+    """Data reports for frame[start:end], each one decodes on its own"""
+    # skip the prefix search for spans RLE can't shrink, like photos or noise
+    if rle and len(bitmaps.encode(frame[start:end])) >= end - start:
+        rle = False
+
+    reports = []
+    pos = start
+    while pos < end:
+        raw = min(proto.FRAME_DATA_CHUNK, end - pos)
+        length, encoded = _longest_rle_prefix(frame[pos:end]) if rle else (0, b"")
+        if length > raw:
+            reports.append(proto.encode_frame_data(proto.FRAME_OP_RLE, pos, encoded))
+            pos += length
+        else:
+            reports.append(proto.encode_frame_data(proto.FRAME_OP_RAW, pos, frame[pos : pos + raw]))
+            pos += raw
+    return reports
+
+
+class FrameEncoder:
+    """
+    Turns whole frames into stream reports for the tiles that changed, keeping
+    a copy of what the macropad shows. Counts what every frame cost.
+    """
+
+    def __init__(self, rle=True):
+        self.rle = rle
+        self.shown = bytes(FRAME_SIZE)
+        self.seq = 0
+        self.frames = 0
+        self.tiles = 0
+        self.reports = 0
+
+    def start(self):
+        """START clears the macropad's screen, so deltas begin from blank"""
+        self.shown = bytes(FRAME_SIZE)
+        return [proto.encode_frame_op(proto.FRAME_OP_START)]
+
+    def stop(self):
+        return [proto.encode_frame_op(proto.FRAME_OP_STOP)]
+
+    def encode(self, frame):
+        frame = bytes(frame)
+        reports = []
+        for start, end in changed_spans(self.shown, frame):
+            self.tiles += (end - start) // TILE_SIZE
+            reports += encode_span(frame, start, end, self.rle)
+
+        self.seq = (self.seq + 1) & 0xFF
+        reports.append(proto.encode_frame_op(proto.FRAME_OP_END, self.seq))
+
+        self.shown = frame
+        self.frames += 1
+        self.reports += len(reports)
+        return reports
+
+    def stats(self):
+        """Per frame averages since the last call"""
+        frames = max(self.frames, 1)
+        stats = {
+            "frames": self.frames,
+            "tiles": self.tiles / frames,
+            "reports": self.reports / frames,
+            "bytes": self.reports * proto.REPORT_LENGTH / frames,
+        }
+        self.frames = self.tiles = self.reports = 0
+        return stats
+
+
+def image_to_frame(image):
+    """Page bytes of a 128x64 Pillow image, lit where the pixel is set"""
+    rows = image.convert("1").tobytes()  # packed rows, most significant bit first
+    stride = WIDTH // 8
+    frame = bytearray(FRAME_SIZE)
+    for y in range(HEIGHT):
+        row = rows[y * stride : (y + 1) * stride]
+        page = (y // 8) * WIDTH
+        bit = 1 << (y % 8)
+        for x in range(WIDTH):
+            if row[x >> 3] & (0x80 >> (x & 7)):
+                frame[page + x] |= bit
+    return frame
+
+
+# -------------------------------------------------------------------------- #
+# Demo
+# -------------------------------------------------------------------------- #
+
+
+class Dashboard:
+    """Clock and a scrolling CPU graph"""
+
+    def __init__(self):
+        from PIL import Image, ImageDraw, ImageFont  # only needed for the demo
+
+        import psutil
+
+        self.Image, self.ImageDraw = Image, ImageDraw
+        self.font = ImageFont.load_default()
+        self.psutil = psutil
+        self.history = [0] * WIDTH
+        self.last_sample = 0
+
+    def render(self):
+        if time.monotonic() - self.last_sample >= 0.25:
+            self.last_sample = time.monotonic()
+            self.history = self.history[1:] + [self.psutil.cpu_percent()]
+
+        image = self.Image.new("1", (WIDTH, HEIGHT))
+        draw = self.ImageDraw.Draw(image)
+        draw.text((0, 0), time.strftime("%H:%M:%S"), fill=1, font=self.font)
+        draw.text((0, 12), f"CPU {self.history[-1]:3.0f}%", fill=1, font=self.font)
+        for x, percent in enumerate(self.history):
+            top = HEIGHT - 1 - int(percent * 35 / 100)
+            draw.line((x, top, x, HEIGHT - 1), fill=1)
+        return image_to_frame(image)
+
+
+def run(args):
+    dashboard = Dashboard()
+    client, reactor = bitmaps.open_macropad(args.macropad)
+    encoder = FrameEncoder(rle=not args.no_rle)
+
+    def send(reports):
+        for report in reports:
+            reactor.write(client.get_report(report))
+
+    interval = 1 / args.fps
+    next_frame = time.monotonic()
+    stats_at = next_frame + 5
+    try:
+        send(encoder.start())
+        while True:
+            send(encoder.encode(dashboard.render()))
+
+            if time.monotonic() >= stats_at:
+                stats = encoder.stats()
+                print(
+                    f"{stats['frames'] / 5:.1f} fps, {stats['tiles']:.1f} tiles, "
+                    f"{stats['reports']:.1f} reports, {stats['bytes']:.0f} bytes per frame"
+                )
+                stats_at += 5
+
+            next_frame += interval
+            delay = next_frame - time.monotonic()
+            if delay > 0:
+                time.sleep(delay)
+            else:
+                next_frame = time.monotonic()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        send(encoder.stop())
+        reactor.stop()
+        reactor.interface.close()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--fps", type=float, default=15)
+    parser.add_argument("--no-rle", action="store_true", help="send changed tiles uncompressed")
+    parser.add_argument("--macropad", type=int, default=0, help="index into MACROPADS")
+    run(parser.parse_args())
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,54 @@
+#include "marquee.h"
+#include <string.h>
+
+static uint16_t text_hash(const char *text) {
+    uint16_t hash = 0;
+    while (*text) {
+        hash = hash * 31 + (uint8_t)*text++;
+    }
+    return hash;
+}
+
+void marquee_set(marquee_t *marquee, const char *text) {
+    uint8_t length = strlen(text);
+    uint16_t hash = text_hash(text);
+
+    marquee->text = text;
+    if (length == marquee->length && hash == marquee->hash) {
+        return;
+    }
+
+    marquee->length = length;
+    marquee->hash = hash;
+    marquee->offset = 0;
+    marquee->last_step = timer_read32();
+}
+
+bool marquee_task(marquee_t *marquee) {
+    if (marquee->length <= RENDER_COLUMNS) {
+        return false;
+    }
+
+    uint16_t delay = marquee->offset ? MARQUEE_STEP_MS : MARQUEE_PAUSE_MS;
+    if (timer_elapsed32(marquee->last_step) < delay) {
+        return false;
+    }
+
+    marquee->last_step = timer_read32();
+    marquee->offset = (marquee->offset + 1) % (marquee->length + MARQUEE_GAP);
+    return true;
+}
+
+void marquee_window(const marquee_t *marquee, char *out) {
+    if (marquee->length <= RENDER_COLUMNS) {
+        strcpy(out, marquee->text ? marquee->text : "");
+        return;
+    }
+
+    uint8_t cycle = marquee->length + MARQUEE_GAP;
+    for (uint8_t i = 0; i < RENDER_COLUMNS; i++) {
+        uint8_t pos = (marquee->offset + i) % cycle;
+        out[i] = pos < marquee->length ? marquee->text[pos] : ' ';
+    }
+    out[RENDER_COLUMNS] = '\0';
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "quantum.h"
+#include "oled_render.h"
+
+// Scrolls a line of text that is wider than the screen, one character every
+// MARQUEE_STEP_MS with a pause of MARQUEE_PAUSE_MS whenever the start comes
+// round again. The text is stored once and scrolled from a firmware timer,
+// so scrolling needs nothing from the host, and since only the marquee's own
+// line changes only that line reaches the OLED. Text that fits never moves.
+
+#ifndef MARQUEE_STEP_MS
+#    define MARQUEE_STEP_MS 300
+#endif
+
+#ifndef MARQUEE_PAUSE_MS
+#    define MARQUEE_PAUSE_MS 2000
+#endif
+
+// blank characters between the end of the text and its start coming round
+#ifndef MARQUEE_GAP
+#    define MARQUEE_GAP 4
+#endif
+
+typedef struct {
+    const char *text;
+    uint8_t length;
+    uint8_t offset;
+    uint16_t hash;
+    uint32_t last_step;
+} marquee_t;
+
+// Points the marquee at text, which must stay valid. The same text again
+// keeps scrolling where it was, so a resent song doesn't jump back.
+void marquee_set(marquee_t *marquee, const char *text);
+
+// Moves the marquee when its step is due, true when the visible text changed
+bool marquee_task(marquee_t *marquee);
+
+// Writes the visible RENDER_COLUMNS characters and a NUL into out
+void marquee_window(const marquee_t *marquee, char *out);
@@ -0,0 +1,133 @@
+#include "oled_render.h"
+#include "print.h"
+#include <string.h>
+
+render_stats_t render_stats;
+
+// text currently on each OLED line
+static char shadow[RENDER_LINES][RENDER_COLUMNS + 1];
+
+static uint8_t cursor_line = 0;
+static bool dirty = true;
+static bool raw_drawn = false;
+static uint32_t last_frame = 0;
+
+// counters for the current stats window
+static uint32_t window_start = 0;
+static uint32_t scans = 0;
+static uint16_t frames = 0;
+static uint16_t frames_skipped = 0;
+static uint16_t lines_written = 0;
+
+void render_mark_dirty(void) {
+    dirty = true;
+}
+
+void render_invalidate(void) {
+    oled_clear();
+    memset(shadow, 0, sizeof(shadow));
+    raw_drawn = false;
+    dirty = true;
+}
+
+bool render_begin_frame(void) {
+#ifndef RENDER_ALWAYS_REDRAW
+    if (timer_elapsed32(last_frame) < RENDER_FRAME_MS) {
+        return false;
+    }
+    last_frame = timer_read32();
+
+    if (!dirty) {
+        frames_skipped++;
+        return false;
+    }
+#endif
+
+    dirty = false;
+    cursor_line = 0;
+    frames++;
+    return true;
+}
+
+void render_ln(const char *text) {
+    if (cursor_line >= RENDER_LINES) {
+        return;
+    }
+
+    char *line = shadow[cursor_line];
+
+#ifndef RENDER_ALWAYS_REDRAW
+    if (strncmp(line, text, RENDER_COLUMNS) == 0) {
+        cursor_line++;
+        return;
+    }
+#endif
+
+    strncpy(line, text, RENDER_COLUMNS);
+    line[RENDER_COLUMNS] = '\0';
+
+    oled_set_cursor(0, cursor_line);
+    oled_write_ln(line, false);
+    lines_written++;
+    cursor_line++;
+}
+
+void render_raw(uint8_t lines, void (*draw)(void)) {
+#ifdef RENDER_ALWAYS_REDRAW
+    raw_drawn = false;
+#endif
+
+    if (!raw_drawn) {
+        draw();
+        raw_drawn = true;
+    }
+
+    if (cursor_line < lines) {
+        cursor_line = lines;
+    }
+}
+
+void render_line_raw(void (*draw)(uint8_t line)) {
+    if (cursor_line >= RENDER_LINES) {
+        return;
+    }
+
+    // never matches any text, so the next render_ln() here rewrites the line
+    shadow[cursor_line][0] = '\x01';
+    shadow[cursor_line][1] = '\0';
+
+    draw(cursor_line);
+    cursor_line++;
+}
+
+void render_end_frame(void) {
+    while (cursor_line < RENDER_LINES) {
+        render_ln("");
+    }
+}
+
+void render_count_scan(void) {
+    scans++;
+
+    uint32_t elapsed = timer_elapsed32(window_start);
+    if (elapsed < RENDER_STATS_MS) {
+        return;
+    }
+
+    render_stats.scan_rate = scans * 1000 / elapsed;
+    render_stats.frames = frames;
+    render_stats.frames_skipped = frames_skipped;
+    render_stats.lines_written = lines_written;
+
+#ifdef CONSOLE_ENABLE
+    uprintf("render: %u scans/s, %u frames, %u skipped, %u lines written\n",
+            render_stats.scan_rate, render_stats.frames,
+            render_stats.frames_skipped, render_stats.lines_written);
+#endif
+
+    window_start = timer_read32();
+    scans = 0;
+    frames = 0;
+    frames_skipped = 0;
+    lines_written = 0;
+}
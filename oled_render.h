@@ -0,0 +1,67 @@
+#pragma once
+
+#include "quantum.h"
+
+// Line-based OLED renderer. A frame is composed with render_ln() into a
+// shadow copy of the screen text and only lines whose text changed reach the
+// OLED driver. Frames are capped at one per RENDER_FRAME_MS and composed only
+// after render_mark_dirty(), so an unchanged screen costs no formatting and
+// no OLED writes at all.
+//
+// Define RENDER_ALWAYS_REDRAW to go back to rewriting every line on every
+// housekeeping pass, which is how the scan rate gain can be compared.
+
+#ifndef RENDER_LINES
+#    define RENDER_LINES 8
+#endif
+
+// text is clipped to this many characters, oled_write_ln would wrap it
+#ifndef RENDER_COLUMNS
+#    define RENDER_COLUMNS 20
+#endif
+
+#ifndef RENDER_FRAME_MS
+#    define RENDER_FRAME_MS 50
+#endif
+
+// scan rate and frame counters are printed to the console once per window
+#ifndef RENDER_STATS_MS
+#    define RENDER_STATS_MS 10000
+#endif
+
+typedef struct {
+    uint16_t scan_rate;      // matrix scans per second over the last window
+    uint16_t frames;         // frames composed in the last window
+    uint16_t frames_skipped; // frames due with nothing dirty in the last window
+    uint16_t lines_written;  // lines that reached the OLED driver in the last window
+} render_stats_t;
+
+extern render_stats_t render_stats;
+
+// The state behind the current screen changed, compose the next frame
+void render_mark_dirty(void);
+
+// Clears the screen and the shadow, the next frame draws everything
+void render_invalidate(void);
+
+// Returns true when a frame should be composed now. Every frame that starts
+// must be finished with render_end_frame().
+bool render_begin_frame(void);
+
+// Next line of the frame, written to the OLED only if it changed
+void render_ln(const char *text);
+
+// The top lines of the screen hold a bitmap that draw() writes into the OLED
+// buffer. It is drawn once after each render_invalidate() since it never
+// changes by itself.
+void render_raw(uint8_t lines, void (*draw)(void));
+
+// Next line of the frame is drawn by draw() straight into the OLED buffer,
+// on every frame. draw() should only write bytes that may have changed.
+void render_line_raw(void (*draw)(uint8_t line));
+
+// Blanks lines the previous frame used and this one didn't
+void render_end_frame(void);
+
+// Call from matrix_scan_user()
+void render_count_scan(void);
@@ -0,0 +1,61 @@
+#include "req_scheduler.h"
+#include "hid_protocol.h"
+#include <string.h>
+
+static bool is_user_request(uint8_t request) {
+    switch (request) {
+        case REQUEST_RETEST:
+        case TIMER_PAUSE_REQ:
+        case TIMER_RESTART_REQ:
+        case TIMER_RESET_REQ:
+        case KEYFRAME_REQ: // stale state on screen until it is served
+            return true;
+    }
+    return false;
+}
+
+static void fifo_push(req_fifo_t *fifo, uint8_t request) {
+    fifo->items[(fifo->head + fifo->count) % REQ_TYPE_LIMIT] = request;
+    fifo->count++;
+}
+
+static uint8_t fifo_pop(req_fifo_t *fifo) {
+    uint8_t request = fifo->items[fifo->head];
+    fifo->head = (fifo->head + 1) % REQ_TYPE_LIMIT;
+    fifo->count--;
+    return request;
+}
+
+void req_scheduler_init(req_scheduler_t *s) {
+    memset(s, 0, sizeof(*s));
+}
+
+bool req_scheduler_push(req_scheduler_t *s, uint8_t request) {
+    if (request == 0 || request >= REQ_TYPE_LIMIT) {
+        s->dropped++;
+        return false;
+    }
+
+    if (req_scheduler_is_pending(s, request)) {
+        s->coalesced++;
+        return false;
+    }
+
+    // a type is in at most one fifo at a time, so neither can overflow
+    s->pending |= 1u << request;
+    fifo_push(is_user_request(request) ? &s->user : &s->polls, request);
+    return true;
+}
+
+bool req_scheduler_pop(req_scheduler_t *s, uint8_t *request) {
+    req_fifo_t *fifo = s->user.count ? &s->user : &s->polls;
+    if (fifo->count == 0) return false;
+
+    *request = fifo_pop(fifo);
+    s->pending &= ~(1u << *request);
+    return true;
+}
+
+bool req_scheduler_is_pending(req_scheduler_t *s, uint8_t request) {
+    return request < REQ_TYPE_LIMIT && (s->pending & (1u << request));
+}
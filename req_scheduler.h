@@ -0,0 +1,34 @@
+#pragma once
+
+#include "quantum.h"
+
+// Requests waiting for the host. Every request type has a single pending bit,
+// so pushing a type that is already waiting is coalesced instead of queued
+// again and the scheduler can never overflow. User commands always drain
+// before periodic polls, each class in FIFO order.
+
+#define REQ_TYPE_LIMIT 16
+
+typedef struct {
+    uint8_t items[REQ_TYPE_LIMIT];
+    uint8_t head;
+    uint8_t count;
+} req_fifo_t;
+
+typedef struct {
+    uint16_t pending;   // one bit per request type
+    req_fifo_t user;    // key presses, served first
+    req_fifo_t polls;   // periodic data polls
+    uint16_t coalesced; // pushes merged into an already pending request
+    uint16_t dropped;   // pushes rejected as invalid
+} req_scheduler_t;
+
+void req_scheduler_init(req_scheduler_t *s);
+
+// Returns false if the request was coalesced or dropped
+bool req_scheduler_push(req_scheduler_t *s, uint8_t request);
+
+// Returns false when nothing is pending
+bool req_scheduler_pop(req_scheduler_t *s, uint8_t *request);
+
+bool req_scheduler_is_pending(req_scheduler_t *s, uint8_t request);
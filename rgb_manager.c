@@ -0,0 +1,91 @@
+#include "rgb_manager.h"
+
+static hsv_t shown;  // last colour given to rgblight
+static hsv_t from;   // start of the current fade
+static hsv_t target;
+static bool fading = false;
+static uint16_t fade_start = 0;
+static uint16_t last_step = 0;
+
+static bool same_colour(hsv_t a, hsv_t b) {
+    return a.h == b.h && a.s == b.s && a.v == b.v;
+}
+
+static void show(hsv_t colour) {
+    if (same_colour(colour, shown)) {
+        return;
+    }
+    shown = colour;
+    rgblight_sethsv_noeeprom(colour.h, colour.s, colour.v);
+}
+
+static uint8_t lerp(uint8_t a, uint8_t b, uint16_t elapsed) {
+    return a + ((int16_t)b - a) * (int32_t)elapsed / RGB_FADE_MS;
+}
+
+// hue is a circle, go the short way round
+static uint8_t lerp_hue(uint8_t a, uint8_t b, uint16_t elapsed) {
+    int16_t diff = (int16_t)b - a;
+    if (diff > 128) diff -= 256;
+    if (diff < -128) diff += 256;
+    return (uint8_t)(a + diff * (int32_t)elapsed / RGB_FADE_MS);
+}
+
+void rgb_manager_init(hsv_t colour) {
+    rgblight_mode_noeeprom(RGBLIGHT_MODE_STATIC_LIGHT);
+    target = colour;
+    fading = false;
+    shown = colour;
+    rgblight_sethsv_noeeprom(colour.h, colour.s, colour.v);
+}
+
+void rgb_manager_fade_to(hsv_t colour) {
+    if (same_colour(colour, target)) {
+        return;
+    }
+
+    from = shown;
+    target = colour;
+    fading = true;
+    fade_start = timer_read();
+    last_step = fade_start;
+}
+
+void rgb_manager_set(hsv_t colour) {
+    target = colour;
+    fading = false;
+    show(colour);
+}
+
+void rgb_manager_set_enabled(bool enabled) {
+    if (enabled) {
+        rgblight_enable();
+    } else {
+        rgblight_disable();
+    }
+}
+
+bool rgb_manager_enabled(void) {
+    return rgblight_is_enabled();
+}
+
+void rgb_manager_task(void) {
+    if (!fading || timer_elapsed(last_step) < RGB_FADE_STEP_MS) {
+        return;
+    }
+    last_step = timer_read();
+
+    uint16_t elapsed = timer_elapsed(fade_start);
+    if (elapsed >= RGB_FADE_MS) {
+        fading = false;
+        show(target);
+        return;
+    }
+
+    hsv_t step = {
+        .h = lerp_hue(from.h, target.h, elapsed),
+        .s = lerp(from.s, target.s, elapsed),
+        .v = lerp(from.v, target.v, elapsed),
+    };
+    show(step);
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "quantum.h"
+
+// Owns the macropad's RGB colour. Colours go through the _noeeprom rgblight
+// setters and only when they actually change, so calling rgb_manager_fade_to()
+// on every OLED frame costs nothing. Layer colours fade over RGB_FADE_MS,
+// stepped from rgb_manager_task(). The only state saved to EEPROM is the
+// on/off toggle, and only when the user flips it.
+
+#ifndef RGB_FADE_MS
+#    define RGB_FADE_MS 300
+#endif
+
+#ifndef RGB_FADE_STEP_MS
+#    define RGB_FADE_STEP_MS 20
+#endif
+
+// Static mode with colour shown straight away, neither is saved
+void rgb_manager_init(hsv_t colour);
+
+// Fades from the colour shown now, does nothing if colour is already the target
+void rgb_manager_fade_to(hsv_t colour);
+
+// Shows colour at once, for blinks and other transient states
+void rgb_manager_set(hsv_t colour);
+
+// Explicit user toggle, saved to EEPROM
+void rgb_manager_set_enabled(bool enabled);
+bool rgb_manager_enabled(void);
+
+// Call from matrix_scan_user()
+void rgb_manager_task(void);
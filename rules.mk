@@ -7,4 +7,4 @@ DEBUG_ENABLE = yes
 RGBLIGHT_ENABLE = yes
 TAP_DANCE_ENABLE = yes
 OLED_DRIVER_ENABLE = yes
-SRC += bitmaps.c
\ No newline at end of file
+SRC += bitmaps.c hid_protocol.c req_scheduler.c oled_render.c rgb_manager.c bitmap_rle.c image_slots.c frame_stream.c marquee.c sparkline.c text_format.c task_scheduler.c macro_player.c
\ No newline at end of file
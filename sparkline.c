@@ -0,0 +1,31 @@
+#include "sparkline.h"
+
+void sparkline_push(sparkline_t *sparkline, uint8_t percent) {
+    if (percent > 100) percent = 100;
+
+    if (sparkline->count < SPARKLINE_WIDTH) {
+        sparkline->samples[(sparkline->head + sparkline->count++) % SPARKLINE_WIDTH] = percent;
+    } else {
+        sparkline->samples[sparkline->head] = percent;
+        sparkline->head = (sparkline->head + 1) % SPARKLINE_WIDTH;
+    }
+}
+
+// a bar rising from the bottom of the line, the top pixel is bit 0
+static uint8_t bar(uint8_t percent) {
+    uint8_t height = (percent * 8 + 99) / 100;
+    return height ? 0xFF << (8 - height) : 0;
+}
+
+void sparkline_draw(const sparkline_t *sparkline, uint8_t line, uint8_t x) {
+    uint16_t index = (uint16_t)line * OLED_DISPLAY_WIDTH + x;
+    uint8_t empty = SPARKLINE_WIDTH - sparkline->count;
+
+    for (uint8_t column = 0; column < SPARKLINE_WIDTH; column++) {
+        uint8_t value = 0;
+        if (column >= empty) {
+            value = bar(sparkline->samples[(sparkline->head + column - empty) % SPARKLINE_WIDTH]);
+        }
+        oled_write_raw_byte(value, index + column);
+    }
+}
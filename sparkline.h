@@ -0,0 +1,25 @@
+#pragma once
+
+#include "quantum.h"
+
+// History graphs one OLED line (8 pixels) high. Every sample is one byte in
+// a fixed ring buffer and one column of the graph, newest on the right, so
+// the host never resends history and a new sample only shifts the columns
+// along by one.
+
+#ifndef SPARKLINE_WIDTH
+#    define SPARKLINE_WIDTH 62
+#endif
+
+typedef struct {
+    uint8_t samples[SPARKLINE_WIDTH]; // percentages, oldest at head once full
+    uint8_t head;
+    uint8_t count;
+} sparkline_t;
+
+// Appends a 0-100 sample, dropping the oldest once the buffer is full
+void sparkline_push(sparkline_t *sparkline, uint8_t percent);
+
+// Draws SPARKLINE_WIDTH columns of bars into OLED line starting at column x.
+// Only bytes that differ from the OLED buffer are marked dirty.
+void sparkline_draw(const sparkline_t *sparkline, uint8_t line, uint8_t x);
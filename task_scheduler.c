@@ -0,0 +1,128 @@
+#include "task_scheduler.h"
+
+typedef struct {
+    uint32_t deadline;
+    task_callback_t callback;
+    void *arg;
+    task_token_t token;
+} task_t;
+
+// heap[0] is always the earliest deadline
+static task_t heap[TASK_SCHEDULER_SIZE];
+static uint8_t count = 0;
+static task_token_t last_token = TASK_TOKEN_NONE;
+
+// the task whose callback is running, it is out of the heap until it returns
+static task_token_t running = TASK_TOKEN_NONE;
+static bool running_cancelled = false;
+
+// deadlines wrap with the timer, so compare them by difference
+static bool earlier(const task_t *a, const task_t *b) {
+    return (int32_t)(a->deadline - b->deadline) < 0;
+}
+
+static void swap(uint8_t a, uint8_t b) {
+    task_t tmp = heap[a];
+    heap[a] = heap[b];
+    heap[b] = tmp;
+}
+
+static void sift_up(uint8_t i) {
+    while (i > 0) {
+        uint8_t parent = (i - 1) / 2;
+        if (!earlier(&heap[i], &heap[parent])) break;
+        swap(i, parent);
+        i = parent;
+    }
+}
+
+static void sift_down(uint8_t i) {
+    while (true) {
+        uint8_t smallest = i;
+        uint8_t left = 2 * i + 1;
+        uint8_t right = left + 1;
+        if (left < count && earlier(&heap[left], &heap[smallest])) smallest = left;
+        if (right < count && earlier(&heap[right], &heap[smallest])) smallest = right;
+        if (smallest == i) break;
+        swap(i, smallest);
+        i = smallest;
+    }
+}
+
+static void push(task_t task) {
+    heap[count] = task;
+    sift_up(count++);
+}
+
+static void remove_at(uint8_t i) {
+    heap[i] = heap[--count];
+    if (i < count) {
+        sift_up(i);
+        sift_down(i);
+    }
+}
+
+static bool token_in_use(task_token_t token) {
+    if (token == running) return true;
+    for (uint8_t i = 0; i < count; i++) {
+        if (heap[i].token == token) return true;
+    }
+    return false;
+}
+
+task_token_t task_schedule(uint32_t delay_ms, task_callback_t callback, void *arg) {
+    // a running task needs its slot back when it returns
+    if (count + (running != TASK_TOKEN_NONE) >= TASK_SCHEDULER_SIZE) return TASK_TOKEN_NONE;
+
+    // skip 0 and any token still held by a long running task
+    do {
+        last_token++;
+    } while (last_token == TASK_TOKEN_NONE || token_in_use(last_token));
+
+    push((task_t){
+        .deadline = timer_read32() + delay_ms,
+        .callback = callback,
+        .arg = arg,
+        .token = last_token,
+    });
+    return last_token;
+}
+
+bool task_cancel(task_token_t token) {
+    if (token == TASK_TOKEN_NONE) return false;
+
+    if (token == running) {
+        running_cancelled = true;
+        return true;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (heap[i].token == token) {
+            remove_at(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void task_scheduler_task(void) {
+    if (count == 0) return;
+
+    uint32_t now = timer_read32();
+    while (count > 0 && timer_expired32(now, heap[0].deadline)) {
+        task_t task = heap[0];
+        remove_at(0);
+
+        running = task.token;
+        running_cancelled = false;
+        uint32_t delay = task.callback(task.deadline, task.arg);
+        running = TASK_TOKEN_NONE;
+
+        if (delay == 0 || running_cancelled) continue;
+
+        // keep a steady period, unless the task fell behind by a whole delay
+        task.deadline += delay;
+        if (timer_expired32(now, task.deadline)) task.deadline = now + delay;
+        push(task);
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "quantum.h"
+
+// Timed tasks for the scan loop. Callbacks use the same convention as QMK's
+// deferred execution: a callback gets the time it was due and returns the
+// delay until it should run again, or 0 to stop. Pending tasks are kept in
+// a min-heap ordered by deadline, so task_scheduler_task() compares the time
+// against the earliest deadline and nothing else until a task is due, however
+// many features register tasks. Each feature schedules its own task where the
+// feature lives instead of adding a timer branch to matrix_scan_user().
+
+#ifndef TASK_SCHEDULER_SIZE
+#    define TASK_SCHEDULER_SIZE 8
+#endif
+
+// 0 is never a valid token, like INVALID_DEFERRED_TOKEN
+typedef uint8_t task_token_t;
+#define TASK_TOKEN_NONE 0
+
+typedef uint32_t (*task_callback_t)(uint32_t trigger_time, void *arg);
+
+// Runs callback delay_ms from now. Returns TASK_TOKEN_NONE when the
+// scheduler is full.
+task_token_t task_schedule(uint32_t delay_ms, task_callback_t callback, void *arg);
+
+// Stops a pending or running task, returns false if it had already stopped
+bool task_cancel(task_token_t token);
+
+// Call from matrix_scan_user(), runs every task that is due
+void task_scheduler_task(void);
@@ -0,0 +1,207 @@
+"""
+Tests for image slot uploads, run on the firmware's image_slots.c and
+bitmap_rle.c built for the host with just enough of QMK stubbed out. Skipped
+when there is no C compiler.
+
+    python -m unittest test_image_slots
+"""
+
+import ctypes
+import os
+import shutil
+import subprocess
+import tempfile
+import unittest
+
+import macropad_bitmaps as bitmaps
+import macropad_protocol as proto
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+EEPROM_SIZE = 4096
+OLED_SIZE = 1024
+
+QUANTUM_H = """
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#define EECONFIG_USER_DATABLOCK eeprom
+extern uint8_t eeprom[];
+uint8_t eeprom_read_byte(const uint8_t *addr);
+void eeprom_read_block(void *buf, const void *addr, size_t len);
+void eeprom_update_byte(uint8_t *addr, uint8_t value);
+void eeprom_update_block(const void *buf, void *addr, size_t len);
+void oled_write_raw_byte(const char data, uint16_t index);
+"""
+
+RAW_HID_H = """
+#pragma once
+#include <stdint.h>
+void raw_hid_send(uint8_t *data, uint8_t length);
+"""
+
+STUBS_C = f"""
+#include <string.h>
+#include "quantum.h"
+
+uint8_t eeprom[{EEPROM_SIZE}];
+uint16_t eeprom_read_end; // one past the furthest EEPROM byte read
+uint8_t oled[{OLED_SIZE}];
+uint8_t last_report[32];
+uint16_t reports_sent;
+
+static void note_read(const void *addr, size_t len) {{
+    uint16_t end = (const uint8_t *)addr - eeprom + len;
+    if (end > eeprom_read_end) eeprom_read_end = end;
+}}
+
+uint8_t eeprom_read_byte(const uint8_t *addr) {{
+    note_read(addr, 1);
+    return *addr;
+}}
+
+void eeprom_read_block(void *buf, const void *addr, size_t len) {{
+    note_read(addr, len);
+    memcpy(buf, addr, len);
+}}
+
+void eeprom_update_byte(uint8_t *addr, uint8_t value) {{
+    *addr = value;
+}}
+
+void eeprom_update_block(const void *buf, void *addr, size_t len) {{
+    memcpy(addr, buf, len);
+}}
+
+void oled_write_raw_byte(const char data, uint16_t index) {{
+    oled[index] = data;
+}}
+
+void raw_hid_send(uint8_t *data, uint8_t length) {{
+    memcpy(last_report, data, sizeof(last_report));
+    reports_sent++;
+}}
+
+void render_invalidate(void) {{}}
+"""
+
+
+def build_firmware(out_dir):
+    """The host build as a ctypes library, None without a C compiler"""
+    compiler = shutil.which("cc") or shutil.which("gcc")
+    if compiler is None:
+        return None
+
+    for name, text in (("quantum.h", QUANTUM_H), ("raw_hid.h", RAW_HID_H), ("stubs.c", STUBS_C)):
+        with open(os.path.join(out_dir, name), "w") as f:
+            f.write(text)
+
+    library = os.path.join(out_dir, "image_slots.so")
+    subprocess.run(
+        [
+            compiler, "-shared", "-fPIC", "-o", library,
+            "-I", out_dir, "-I", HERE,
+            os.path.join(out_dir, "stubs.c"),
+            os.path.join(HERE, "image_slots.c"),
+            os.path.join(HERE, "bitmap_rle.c"),
+        ],
+        check=True,
+    )
+    firmware = ctypes.CDLL(library)
+    # ctypes assumes int, only the low byte of a bool return is defined
+    firmware.image_slots_receive.restype = ctypes.c_bool
+    firmware.image_slots_album_art.restype = ctypes.c_bool
+    return firmware
+
+
+def test_image():
+    """A BITMAP_SIZE image that compresses into literal, repeat and fill runs"""
+    image = bytearray()
+    for i in range(bitmaps.BITMAP_SIZE):
+        if i % 96 < 64:
+            image.append((i * 7) % 251)
+        else:
+            image.append(0xFF if i % 192 < 96 else 0x55)
+    return bytes(image)
+
+
+class ImageSlotsTest(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        cls.build_dir = tempfile.mkdtemp()
+        cls.firmware = build_firmware(cls.build_dir)
+        if cls.firmware is None:
+            raise unittest.SkipTest("no C compiler")
+
+    @classmethod
+    def tearDownClass(cls):
+        shutil.rmtree(cls.build_dir)
+
+    def setUp(self):
+        self.eeprom = (ctypes.c_uint8 * EEPROM_SIZE).in_dll(self.firmware, "eeprom")
+        self.oled = (ctypes.c_uint8 * OLED_SIZE).in_dll(self.firmware, "oled")
+        self.last_report = (ctypes.c_uint8 * 32).in_dll(self.firmware, "last_report")
+        self.reports_sent = ctypes.c_uint16.in_dll(self.firmware, "reports_sent")
+        self.read_end = ctypes.c_uint16.in_dll(self.firmware, "eeprom_read_end")
+
+        ctypes.memset(self.eeprom, 0, EEPROM_SIZE)
+        self.firmware.image_slots_init()
+
+    def send(self, report):
+        buffer = (ctypes.c_uint8 * len(report)).from_buffer_copy(report)
+        self.assertTrue(self.firmware.image_slots_receive(buffer, len(report)))
+
+    def upload(self, slot, data):
+        """Final decode_image_status() of an upload, running the write task as needed"""
+        for report in proto.encode_image_upload(slot, data):
+            self.send(report)
+
+        sent = self.reports_sent.value
+        for _ in range(10000):
+            if self.reports_sent.value != sent:
+                break
+            self.firmware.image_slots_task()
+        return proto.decode_image_status(bytes(self.last_report))
+
+    def test_whole_image_is_stored_and_drawn(self):
+        image = test_image()
+        status = self.upload(0, bitmaps.encode(image))
+
+        self.assertEqual(status[1], proto.IMAGE_OK)
+        self.assertEqual(self.firmware.image_slots_available(), 1)
+
+        self.firmware.image_slots_draw(0)
+        self.assertEqual(bytes(self.oled[: bitmaps.BITMAP_SIZE]), image)
+
+    def test_truncated_stream_is_rejected(self):
+        data = bitmaps.encode(test_image())
+        status = self.upload(0, data[: len(data) // 2])
+
+        self.assertEqual(status[1], proto.IMAGE_ERR_LENGTH)
+        self.assertEqual(status[3], 0)  # valid slot mask
+        self.assertEqual(self.firmware.image_slots_available(), 0)
+
+    def test_truncated_album_art_is_rejected(self):
+        data = bitmaps.encode(test_image())
+        status = self.upload(proto.IMAGE_SLOT_ALBUM_ART, data[:-1])
+
+        self.assertEqual(status[1], proto.IMAGE_ERR_LENGTH)
+        self.assertFalse(self.firmware.image_slots_album_art())
+
+    def test_draw_reads_only_the_stored_length(self):
+        # a slot left by firmware that didn't check the stream on COMMIT
+        data = bitmaps.encode(test_image())[:100]
+        crc = proto.crc16(data)
+        header = bytes([0xA5, len(data) & 0xFF, len(data) >> 8, crc & 0xFF, crc >> 8])
+        self.eeprom[: len(header) + len(data)] = header + data
+        self.firmware.image_slots_init()
+        self.assertEqual(self.firmware.image_slots_available(), 1)
+
+        self.read_end.value = 0
+        self.firmware.image_slots_draw(0)
+        self.assertLessEqual(self.read_end.value, len(header) + len(data))
+
+
+if __name__ == "__main__":
+    unittest.main()
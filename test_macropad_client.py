@@ -0,0 +1,172 @@
+"""
+Tests for the client's protocol handling, run without a macropad and without
+the client's optional dependencies.
+
+    python -m unittest test_macropad_client
+"""
+
+import sys
+import threading
+import time
+import types
+import unittest
+
+
+def _stub_missing(name, **attributes):
+    """Stands in for a dependency that isn't installed, only what import needs"""
+    try:
+        __import__(name)
+    except ImportError:
+        module = types.ModuleType(name)
+        module.__dict__.update(attributes)
+        sys.modules[name] = module
+
+
+class _Unavailable:
+    def __init__(self, *args, **kwargs):
+        raise RuntimeError("not available in tests")
+
+
+_stub_missing("hid", enumerate=lambda *args: [], device=_Unavailable)
+_stub_missing(
+    "psutil",
+    cpu_percent=lambda interval=None: 0.0,
+    virtual_memory=lambda: types.SimpleNamespace(percent=0.0),
+    sensors_battery=lambda: None,
+)
+_stub_missing("speedtest", Speedtest=_Unavailable)
+_stub_missing("spotipy", Spotify=_Unavailable)
+_stub_missing("spotipy.oauth2", SpotifyOAuth=_Unavailable)
+_stub_missing("dotenv", load_dotenv=lambda *args, **kwargs: None)
+
+_stdout, _stderr = sys.stdout, sys.stderr
+import macropad_client_hid as client
+
+# the client silences output for its .exe build
+sys.stdout, sys.stderr = _stdout, _stderr
+
+import macropad_protocol as proto
+
+
+class FakeFirmware:
+    """What LinkState.configure() reads from a macropad's hello"""
+
+    def __init__(self, capabilities):
+        self.capabilities = capabilities
+        self.report_size = client.report_length
+        self.providers = proto.ALL_PROVIDERS
+
+    def has(self, capability):
+        return bool(self.capabilities & capability)
+
+
+def delta_records(reports, provider=proto.PROVIDER_PC):
+    """(generation, mask) of the provider's TLV_DELTA records in a list of reports"""
+    index = provider.bit_length() - 1
+    records = []
+    for report in reports:
+        for record_type, value in proto.decode_report(report[1:]):
+            if record_type == proto.TLV_DELTA and value[0] == index:
+                records.append((value[1], value[2]))
+    return records
+
+
+class PollingDeltaTest(unittest.TestCase):
+    """Request/response loop with delta encoding (EVENT_DRIVEN = False)"""
+
+    def setUp(self):
+        self.saved = client.EVENT_DRIVEN, client.DELTA_MODE
+        client.EVENT_DRIVEN, client.DELTA_MODE = False, True
+        self.pc_source = client.sampler.sources[proto.PROVIDER_PC]
+        client.sampler.sources[proto.PROVIDER_PC] = lambda: (42, 17, 0)
+        client.sampler.invalidate(proto.PROVIDER_PC)
+
+        link = client.LinkState()
+        link.configure(FakeFirmware(proto.CAP_TLV | proto.CAP_DELTA))
+        self.publisher = client.ProviderPublisher(link)
+
+    def tearDown(self):
+        client.EVENT_DRIVEN, client.DELTA_MODE = self.saved
+        client.sampler.sources[proto.PROVIDER_PC] = self.pc_source
+        client.album_art.listeners.remove(self.publisher.wake.set)
+
+    def answer(self, request):
+        """What the client writes back for one macropad report, marked written"""
+        reports = client.interpret_response(bytes([request]) + bytes(31), self.publisher)
+        self.publisher.sent()
+        return reports
+
+    def test_unchanged_stats_still_get_an_answer(self):
+        first = delta_records(self.answer(client.PC_PERFORMANCE))
+        self.assertEqual(first, [(0, proto.full_mask(proto.PROVIDER_PC))])
+
+        # nothing changed, but the macropad waits for an answer either way
+        unchanged = self.answer(client.PC_PERFORMANCE)
+        self.assertTrue(unchanged)
+        self.assertEqual(delta_records(unchanged), [(1, 0)])
+
+    def test_idle_reply_gets_an_answer(self):
+        self.answer(client.PC_PERFORMANCE)
+        self.assertTrue(self.answer(0))
+
+    def test_unwritten_delta_is_not_committed(self):
+        client.interpret_response(bytes([client.PC_PERFORMANCE]) + bytes(31), self.publisher)
+
+        # the first message never went out, so the next one is still a keyframe
+        reports = self.answer(client.PC_PERFORMANCE)
+        self.assertEqual(delta_records(reports), [(0, proto.full_mask(proto.PROVIDER_PC))])
+
+
+class FakeInterface:
+    """Accepts every write, the test plays the macropad's side by dispatching"""
+
+    def write(self, report):
+        return len(report)
+
+
+class ReactorPairingTest(unittest.TestCase):
+    def setUp(self):
+        self.reactor = client.HidReactor(FakeInterface())
+
+    def request_in_background(self, results):
+        thread = threading.Thread(target=lambda: results.append(self.reactor.request([b"\0"], timeout=2)))
+        thread.start()
+        # wait until the request is registered and written
+        while not self.reactor.waiters:
+            time.sleep(0.001)
+        return thread
+
+    def test_late_answer_is_not_given_to_the_next_request(self):
+        self.assertEqual(self.reactor.request([b"\0"], timeout=0.01), [])
+
+        # the late answer turns up before the next request is written
+        self.reactor._dispatch(b"late")
+        results = []
+        thread = self.request_in_background(results)
+        self.reactor._dispatch(b"answer")
+        thread.join()
+
+        self.assertEqual(results, [b"answer"])
+        stats = self.reactor.stats()
+        self.assertEqual(stats["timed_out"], 1)
+        self.assertEqual(stats["misrouted"], 1)
+        self.assertEqual(stats["responses"], 1)
+
+    def test_lost_answer_does_not_stall_later_polls(self):
+        self.assertEqual(self.reactor.request([b"\0"], timeout=0.01), [])
+
+        # the answer to that request never comes, every later one must get through
+        for poll in range(10):
+            results = []
+            thread = self.request_in_background(results)
+            self.reactor._dispatch(b"answer %d" % poll)
+            thread.join()
+            self.assertEqual(results, [b"answer %d" % poll])
+
+        stats = self.reactor.stats()
+        self.assertEqual(stats["responses"], 10)
+        self.assertEqual(stats["misrouted"], 0)
+        self.assertEqual(stats["timed_out"], 1)
+
+if __name__ == "__main__":
+    unittest.main()
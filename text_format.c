@@ -0,0 +1,79 @@
+#include "text_format.h"
+#include <string.h>
+
+char *format_str(char *out, const char *text) {
+    while (*text) {
+        *out++ = *text++;
+    }
+    *out = '\0';
+    return out;
+}
+
+char *format_uint(char *out, uint32_t value, uint8_t width) {
+    // digits come out backwards, least significant first
+    char digits[FORMAT_UINT_MAX];
+    uint8_t n = 0;
+    do {
+        digits[n++] = '0' + value % 10;
+        value /= 10;
+    } while (value);
+
+    while (width > n) {
+        *out++ = '0';
+        width--;
+    }
+    while (n) {
+        *out++ = digits[--n];
+    }
+    *out = '\0';
+    return out;
+}
+
+char *format_fixed_x10(char *out, uint16_t value_x10) {
+    out = format_uint(out, value_x10 / 10, 1);
+    *out++ = '.';
+    return format_uint(out, value_x10 % 10, 1);
+}
+
+char *format_mmss(char *out, uint32_t seconds) {
+    out = format_uint(out, seconds / 60, 2);
+    *out++ = ':';
+    return format_uint(out, seconds % 60, 2);
+}
+
+char *format_hhmmss(char *out, uint32_t seconds) {
+    out = format_uint(out, seconds / 3600, 2);
+    *out++ = ':';
+    return format_mmss(out, seconds % 3600);
+}
+
+bool parse_uint(const char *str, uint32_t *out) {
+    if (*str < '0' || *str > '9') return false;
+    uint32_t value = 0;
+    while (*str >= '0' && *str <= '9') {
+        value = value * 10 + (*str++ - '0');
+    }
+    *out = value;
+    return true;
+}
+
+uint16_t parse_fixed_x10(const char *str) {
+    uint32_t whole = 0;
+    parse_uint(str, &whole);
+    const char *dot = strchr(str, '.');
+    uint32_t tenths = 0;
+    if (dot && dot[1] >= '0' && dot[1] <= '9') tenths = dot[1] - '0';
+    return (uint16_t)(whole * 10 + tenths);
+}
+
+uint32_t parse_hms(const char *str) {
+    uint32_t total = 0;
+    while (*str) {
+        uint32_t part = 0;
+        if (!parse_uint(str, &part)) break;
+        total = total * 60 + part;
+        while (*str >= '0' && *str <= '9') str++;
+        if (*str == ':') str++;
+    }
+    return total;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "quantum.h"
+
+// Small replacements for the snprintf and sscanf formats the OLED screens
+// and the legacy ASCII reports need, so neither pulls in libc's printf or
+// scanf. Every format_* writes at out and returns a pointer to the '\0' it
+// ends with, so a line is built by chaining calls:
+//
+//     char *p = format_str(line, "RAM:");
+//     p = format_uint(p, ram, 2);
+//
+// The caller makes sure the buffer is big enough, FORMAT_UINT_MAX is the
+// longest number.
+
+// digits of the largest uint32_t
+#define FORMAT_UINT_MAX 10
+
+// Copies text
+char *format_str(char *out, const char *text);
+
+// Decimal, zero padded to at least width digits ("%0*lu")
+char *format_uint(char *out, uint32_t value, uint8_t width);
+
+// Tenths as a decimal with one place, 123 -> "12.3"
+char *format_fixed_x10(char *out, uint16_t value_x10);
+
+// Seconds as "mm:ss", minutes are never wrapped into hours
+char *format_mmss(char *out, uint32_t seconds);
+
+// Seconds as "hh:mm:ss", hours grow past two digits when they need to
+char *format_hhmmss(char *out, uint32_t seconds);
+
+// Parses leading digits, returns false when there are none
+bool parse_uint(const char *str, uint32_t *out);
+
+// "12.34" -> 123 (one decimal place, truncated)
+uint16_t parse_fixed_x10(const char *str);
+
+// "hh:mm:ss", "mm:ss" or "ss" -> seconds
+uint32_t parse_hms(const char *str);